@@ -0,0 +1,589 @@
+/*
+ * Benchmark - Times the basic operations of DoublyLinkedList,
+ * CircularDoublyLinkedList, CircularBuffer, DoubleStack, Deque and typed
+ * lists of a few element types, on sizes from 10 up to 10^7 elements.
+ * Prints a table and writes the same results to bench_output.txt, one
+ * tab-separated record per line:
+ *   container  type  operation  size  operations  ns/op  bytes/element
+ * Lines starting with # are comments. bytes/element counts the nodes or
+ * arrays a container allocates (not malloc's own overhead) over its size.
+ * With -p, every operation is also run under hardware performance counters
+ * (see PerfCounters.h), and each record goes on with cycles, instructions,
+ * L1d misses, LLC misses and branch misses per operation, or - for a
+ * counter the machine or kernel won't give out. That shows what the
+ * pointer chasing of the lists costs in cache misses next to the arrays of
+ * CircularBuffer, DoubleStack and Deque.
+ * Build: cc -std=c11 -O2 Benchmark.c DoublyLinkedList.c
+ *        CircularDoublyLinkedList.c CircularBuffer.c DoubleStack.c Deque.c
+ *        PerfCounters.c
+ * Usage: ./a.out [-p] [largest size]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "DoublyLinkedList.h"
+#include "CircularDoublyLinkedList.h"
+#include "CircularBuffer.h"
+#include "DoubleStack.h"
+#include "Deque.h"
+#include "TypedDoublyLinkedList.h"
+#include "PerfCounters.h"
+
+#define BENCHMARK_MAX_SIZE 10000000	// largest size timed by default
+#define BENCHMARK_MIN_OPS 1000000	// each size is repeated until this many elements
+#define BENCHMARK_WALK_BUDGET 50000000	// nodes an O(n) operation may visit per size
+#define BENCHMARK_OUTPUT "bench_output.txt"
+
+/*
+ * Every operation that gets timed. Not every container has all of them.
+ */
+typedef enum
+{
+	OP_PUSH_TAIL,
+	OP_PUSH_HEAD,
+	OP_POP_TAIL,
+	OP_POP_HEAD,
+	OP_INSERT_MID,
+	OP_REMOVE_MID,
+	OP_FIND_HIT,
+	OP_FIND_MISS,
+	OP_SORTED_INSERT,
+	OP_TRAVERSE,
+	OP_ROTATE,
+	OP_COUNT
+}BenchmarkOp;
+
+static const char* const Benchmark_opNames[OP_COUNT] =
+{
+	"pushTail", "pushHead", "popTail", "popHead", "insertMid", "removeMid",
+	"findHit", "findMiss", "sortedInsert", "traverse", "rotate"
+};
+
+/*
+ * Time spent on, operations done of, and (with -p) events counted during
+ * each BenchmarkOp, summed over the rounds of one container at one size.
+ */
+typedef struct
+{
+	double seconds[OP_COUNT];
+	double operations[OP_COUNT];
+	double counts[OP_COUNT][PERF_EVENT_COUNT];
+	double bytesPerElement;
+}BenchmarkTimes;
+
+/*
+ * A 32-byte element type for the typed lists, compared by key.
+ */
+typedef struct
+{
+	long long key;
+	char payload[24];
+}Record;
+
+#define RECORD_COMPARE(VAL1, VAL2) DLL_DEFAULT_COMPARE((VAL1).key, (VAL2).key)
+#define MAKE_INT(I) ((int)(I))
+#define MAKE_DOUBLE(I) ((double)(I))
+#define MAKE_RECORD(I) Benchmark_record(I)
+
+DLL_DECLARE(IntList, int)
+DLL_DEFINE(IntList, int, DLL_DEFAULT_COMPARE)
+DLL_DECLARE(DoubleList, double)
+DLL_DEFINE(DoubleList, double, DLL_DEFAULT_COMPARE)
+DLL_DECLARE(RecordList, Record)
+DLL_DEFINE(RecordList, Record, RECORD_COMPARE)
+
+static volatile double sink;	// keeps traversals from being optimized away
+static double startTime;
+static PerfCounters* counters;	// only with -p
+
+/*
+ * Returns the time in seconds on a monotonic clock.
+ */
+static double Benchmark_now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+/*
+ * Starts timing (and counting) an operation.
+ */
+static void Benchmark_start()
+{
+	if(counters != NULL) PerfCounters_start(counters);
+	startTime = Benchmark_now();
+}
+/*
+ * Stops timing op, which was done operations times.
+ */
+static void Benchmark_stop(BenchmarkTimes* times, BenchmarkOp op, size_t operations)
+{
+	times->seconds[op] += Benchmark_now() - startTime;
+	if(counters != NULL) PerfCounters_stop(counters, times->counts[op]);
+	times->operations[op] += (double)operations;
+}
+/*
+ * Returns how many rounds are run on n elements, so that small sizes are
+ * timed on at least BENCHMARK_MIN_OPS elements.
+ */
+static size_t Benchmark_rounds(size_t n)
+{
+	return n < BENCHMARK_MIN_OPS ? BENCHMARK_MIN_OPS / n : 1;
+}
+/*
+ * Returns how many times per round an O(n) operation is run on n elements,
+ * so that every size costs about BENCHMARK_WALK_BUDGET over all its rounds.
+ */
+static size_t Benchmark_walks(size_t n)
+{
+	size_t walks = BENCHMARK_WALK_BUDGET / (n * Benchmark_rounds(n));
+	if(walks > n) walks = n;
+	return walks ? walks : 1;
+}
+/*
+ * Returns a Record with key i.
+ */
+static Record Benchmark_record(long long i)
+{
+	Record record;
+	record.key = i;
+	memset(record.payload, 0, sizeof(record.payload));
+	return record;
+}
+
+/*
+ * Times a DoublyLinkedList of n E's holding 0, 2, 4, ...
+ */
+static void Benchmark_doublyLinkedList(size_t n, BenchmarkTimes* times)
+{
+	size_t walks = Benchmark_walks(n);
+	size_t i;
+	DoublyLinkedList* dll = DoublyLinkedList_create();
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_pushTail(dll, (E)(2 * i));
+	Benchmark_stop(times, OP_PUSH_TAIL, n);
+	times->bytesPerElement = (double)(n * sizeof(DLLNode) + sizeof(DoublyLinkedList)) / n;
+
+	DLLNode* node;
+	E sum = 0;
+	Benchmark_start();
+	DLL_TRAVERSAL(dll, node)
+		sum += node->data;
+	Benchmark_stop(times, OP_TRAVERSE, n);
+	sink = (double)sum;
+
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+		sink = (double)(DoublyLinkedList_find(dll, (E)(2 * ((i * 7919) % n))) != NULL);
+	Benchmark_stop(times, OP_FIND_HIT, walks);
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+		sink = (double)(DoublyLinkedList_find(dll, (E)-1) != NULL);
+	Benchmark_stop(times, OP_FIND_MISS, walks);
+
+	DLLNode* middle = dll->head;
+	for(i = 0; i < n / 2; i++)
+		middle = middle->next;
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_insertAfter(middle, (E)1);
+	Benchmark_stop(times, OP_INSERT_MID, n);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_remove(middle->next);
+	Benchmark_stop(times, OP_REMOVE_MID, n);
+
+	// the list is still in ascending order, so it can be auto-sorted
+	dll->sorted = 1;
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+		DoublyLinkedList_sortedInsert(dll, (E)(2 * ((i * 7919) % n) + 1));
+	Benchmark_stop(times, OP_SORTED_INSERT, walks);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_popTail(dll);
+	Benchmark_stop(times, OP_POP_TAIL, n);
+	DoublyLinkedList_free(dll);
+
+	dll = DoublyLinkedList_create();
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_pushHead(dll, (E)i);
+	Benchmark_stop(times, OP_PUSH_HEAD, n);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoublyLinkedList_popHead(dll);
+	Benchmark_stop(times, OP_POP_HEAD, n);
+	DoublyLinkedList_free(dll);
+}
+
+/*
+ * Defines Benchmark_NAME, which times a typed list NAME of n elements
+ * holding MAKE(0), MAKE(2), MAKE(4), ... the same way as
+ * Benchmark_doublyLinkedList. SUM(data) turns an element into a number.
+ */
+#define BENCHMARK_TYPED_LIST(NAME, MAKE, SUM)							\
+static void Benchmark_##NAME(size_t n, BenchmarkTimes* times)			\
+{																		\
+	size_t walks = Benchmark_walks(n);									\
+	size_t i;															\
+	NAME* dll = NAME##_create();										\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_pushTail(dll, MAKE(2 * i));								\
+	Benchmark_stop(times, OP_PUSH_TAIL, n);								\
+	times->bytesPerElement = (double)(n * sizeof(NAME##Node) + sizeof(NAME)) / n;	\
+	NAME##Node* node;													\
+	double sum = 0;														\
+	Benchmark_start();													\
+	DLL_TRAVERSAL(dll, node)											\
+		sum += SUM(node->data);											\
+	Benchmark_stop(times, OP_TRAVERSE, n);								\
+	sink = sum;															\
+	Benchmark_start();													\
+	for(i = 0; i < walks; i++)											\
+		sink = (double)(NAME##_find(dll, MAKE(2 * ((i * 7919) % n))) != NULL);	\
+	Benchmark_stop(times, OP_FIND_HIT, walks);							\
+	Benchmark_start();													\
+	for(i = 0; i < walks; i++)											\
+		sink = (double)(NAME##_find(dll, MAKE(-1)) != NULL);			\
+	Benchmark_stop(times, OP_FIND_MISS, walks);							\
+	NAME##Node* middle = dll->head;										\
+	for(i = 0; i < n / 2; i++)											\
+		middle = middle->next;											\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_insertAfter(dll, middle, MAKE(1));						\
+	Benchmark_stop(times, OP_INSERT_MID, n);							\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_remove(dll, middle->next);								\
+	Benchmark_stop(times, OP_REMOVE_MID, n);							\
+	dll->sorted = 1;													\
+	Benchmark_start();													\
+	for(i = 0; i < walks; i++)											\
+		NAME##_sortedInsert(dll, MAKE(2 * ((i * 7919) % n) + 1));		\
+	Benchmark_stop(times, OP_SORTED_INSERT, walks);						\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_popTail(dll);											\
+	Benchmark_stop(times, OP_POP_TAIL, n);								\
+	NAME##_free(dll);													\
+	dll = NAME##_create();												\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_pushHead(dll, MAKE(i));									\
+	Benchmark_stop(times, OP_PUSH_HEAD, n);								\
+	Benchmark_start();													\
+	for(i = 0; i < n; i++)												\
+		NAME##_popHead(dll);											\
+	Benchmark_stop(times, OP_POP_HEAD, n);								\
+	NAME##_free(dll);													\
+}
+
+#define SUM_NUMBER(DATA) (DATA)
+#define SUM_RECORD(DATA) ((DATA).key)
+BENCHMARK_TYPED_LIST(IntList, MAKE_INT, SUM_NUMBER)
+BENCHMARK_TYPED_LIST(DoubleList, MAKE_DOUBLE, SUM_NUMBER)
+BENCHMARK_TYPED_LIST(RecordList, MAKE_RECORD, SUM_RECORD)
+
+/*
+ * Times a CircularDoublyLinkedList of n E's. It can only add at the tail,
+ * remove the handle and be walked, so find is a walk too.
+ */
+static void Benchmark_circularDoublyLinkedList(size_t n, BenchmarkTimes* times)
+{
+	size_t walks = Benchmark_walks(n);
+	size_t i;
+	CircularDoublyLinkedList cdll;
+	CircularDoublyLinkedList_init(&cdll);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		CircularDoublyLinkedList_addEntry(&cdll, (E)(2 * i));
+	Benchmark_stop(times, OP_PUSH_TAIL, n);
+	times->bytesPerElement = (double)(n * sizeof(CDLLNode) + sizeof(CircularDoublyLinkedList)) / n;
+
+	CDLLNode* node;
+	int j;
+	E sum = 0;
+	Benchmark_start();
+	CDLL_TRAVERSAL(&cdll, node, j)
+		sum += node->data;
+	Benchmark_stop(times, OP_TRAVERSE, n);
+	sink = (double)sum;
+
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		E value = (E)(2 * ((i * 7919) % n));
+		CDLL_TRAVERSAL(&cdll, node, j)
+			if(node->data == value) break;
+		sink = (double)j;
+	}
+	Benchmark_stop(times, OP_FIND_HIT, walks);
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		CDLL_TRAVERSAL(&cdll, node, j)
+			if(node->data == (E)-1) break;
+		sink = (double)j;
+	}
+	Benchmark_stop(times, OP_FIND_MISS, walks);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		cdll.handle = cdll.handle->next;
+	Benchmark_stop(times, OP_ROTATE, n);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		CircularDoublyLinkedList_removeEntry(&cdll);
+	Benchmark_stop(times, OP_POP_HEAD, n);
+}
+/*
+ * Times a CircularBuffer of n E's, the same way as
+ * Benchmark_circularDoublyLinkedList.
+ */
+static void Benchmark_circularBuffer(size_t n, BenchmarkTimes* times)
+{
+	size_t walks = Benchmark_walks(n);
+	size_t i;
+	CircularBuffer* cb = CircularBuffer_create(0);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		CircularBuffer_addEntry(cb, (E)(2 * i));
+	Benchmark_stop(times, OP_PUSH_TAIL, n);
+	times->bytesPerElement = (double)(cb->capacity * sizeof(E) + sizeof(CircularBuffer)) / n;
+
+	CBCursor cursor;
+	E sum = 0;
+	Benchmark_start();
+	CB_TRAVERSAL(cb, cursor)
+		sum += CircularBuffer_getData(cursor);
+	Benchmark_stop(times, OP_TRAVERSE, n);
+	sink = (double)sum;
+
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		E value = (E)(2 * ((i * 7919) % n));
+		CB_TRAVERSAL(cb, cursor)
+			if(CircularBuffer_getData(cursor) == value) break;
+		sink = (double)cursor.offset;
+	}
+	Benchmark_stop(times, OP_FIND_HIT, walks);
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		CB_TRAVERSAL(cb, cursor)
+			if(CircularBuffer_getData(cursor) == (E)-1) break;
+		sink = (double)cursor.offset;
+	}
+	Benchmark_stop(times, OP_FIND_MISS, walks);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		CircularBuffer_rotateNext(cb);
+	Benchmark_stop(times, OP_ROTATE, n);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		CircularBuffer_removeEntry(cb);
+	Benchmark_stop(times, OP_POP_HEAD, n);
+	CircularBuffer_free(cb);
+}
+/*
+ * Times a DoubleStack of n doubles. It only has one end, and find and
+ * traverse are walks over its array.
+ */
+static void Benchmark_doubleStack(size_t n, BenchmarkTimes* times)
+{
+	size_t walks = Benchmark_walks(n);
+	size_t i, j;
+	DoubleStack* ds = DoubleStack_create(0);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		DoubleStack_push(ds, (double)(2 * i));
+	Benchmark_stop(times, OP_PUSH_TAIL, n);
+	times->bytesPerElement = (double)(ds->capacity * sizeof(double) + sizeof(DoubleStack)) / n;
+
+	double sum = 0;
+	Benchmark_start();
+	for(i = 0; i < ds->index; i++)
+		sum += ds->values[i];
+	Benchmark_stop(times, OP_TRAVERSE, n);
+	sink = sum;
+
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		double value = (double)(2 * ((i * 7919) % n));
+		for(j = 0; j < ds->index; j++)
+			if(ds->values[j] == value) break;
+		sink = (double)j;
+	}
+	Benchmark_stop(times, OP_FIND_HIT, walks);
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		for(j = 0; j < ds->index; j++)
+			if(ds->values[j] == -1.0) break;
+		sink = (double)j;
+	}
+	Benchmark_stop(times, OP_FIND_MISS, walks);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		sink = DoubleStack_pop(ds);
+	Benchmark_stop(times, OP_POP_TAIL, n);
+	DoubleStack_free(ds);
+}
+/*
+ * Times a Deque of n E's. It only has the four end operations, and find
+ * and traverse walk it a block at a time.
+ */
+static void Benchmark_deque(size_t n, BenchmarkTimes* times)
+{
+	size_t walks = Benchmark_walks(n);
+	size_t i;
+	Deque* dq = Deque_create();
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		Deque_pushTail(dq, (E)(2 * i));
+	Benchmark_stop(times, OP_PUSH_TAIL, n);
+	size_t blocks = (n + DEQUE_BLOCK_SIZE - 1) / DEQUE_BLOCK_SIZE;
+	times->bytesPerElement = (double)(blocks * DEQUE_BLOCK_SIZE * sizeof(E) +
+			dq->mapSize * sizeof(E*) + sizeof(Deque)) / n;
+
+	DequeCursor cursor;
+	E sum = 0;
+	Benchmark_start();
+	DEQUE_TRAVERSAL(dq, cursor)
+		sum += *cursor.data;
+	Benchmark_stop(times, OP_TRAVERSE, n);
+	sink = (double)sum;
+
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		E value = (E)(2 * ((i * 7919) % n));
+		DEQUE_TRAVERSAL(dq, cursor)
+			if(*cursor.data == value) break;
+		sink = (double)cursor.remaining;
+	}
+	Benchmark_stop(times, OP_FIND_HIT, walks);
+	Benchmark_start();
+	for(i = 0; i < walks; i++)
+	{
+		DEQUE_TRAVERSAL(dq, cursor)
+			if(*cursor.data == (E)-1) break;
+		sink = (double)cursor.remaining;
+	}
+	Benchmark_stop(times, OP_FIND_MISS, walks);
+
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		sink = (double)Deque_popTail(dq);
+	Benchmark_stop(times, OP_POP_TAIL, n);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		Deque_pushHead(dq, (E)i);
+	Benchmark_stop(times, OP_PUSH_HEAD, n);
+	Benchmark_start();
+	for(i = 0; i < n; i++)
+		sink = (double)Deque_popHead(dq);
+	Benchmark_stop(times, OP_POP_HEAD, n);
+	Deque_free(dq);
+}
+
+/*
+ * Runs body on n elements as many times as it takes to reach
+ * BENCHMARK_MIN_OPS elements, and reports every operation it timed to the
+ * terminal and to output.
+ */
+static void Benchmark_run(FILE* output, const char* container, const char* type,
+		void (*body)(size_t, BenchmarkTimes*), size_t n)
+{
+	BenchmarkTimes times;
+	size_t rounds = Benchmark_rounds(n);
+	size_t r;
+	int op;
+	memset(&times, 0, sizeof(times));
+	for(r = 0; r < rounds; r++)
+		body(n, &times);
+	for(op = 0; op < OP_COUNT; op++)
+	{
+		if(times.operations[op] == 0) continue;
+		double ns = times.seconds[op] * 1e9 / times.operations[op];
+		printf("%-26s %-12s %-13s %9zu %12.2f %10.1f", container, type,
+				Benchmark_opNames[op], n, ns, times.bytesPerElement);
+		if(output != NULL)
+			fprintf(output, "%s\t%s\t%s\t%zu\t%.0f\t%.3f\t%.2f", container, type,
+					Benchmark_opNames[op], n, times.operations[op], ns, times.bytesPerElement);
+		int event;
+		for(event = 0; counters != NULL && event < PERF_EVENT_COUNT; event++)
+		{
+			if(!PerfCounters_isAvailable(counters, event))
+			{
+				printf(" %13s", "-");
+				if(output != NULL) fprintf(output, "\t-");
+				continue;
+			}
+			double perOp = times.counts[op][event] / times.operations[op];
+			printf(" %13.2f", perOp);
+			if(output != NULL) fprintf(output, "\t%.3f", perOp);
+		}
+		printf("\n");
+		if(output != NULL) fprintf(output, "\n");
+	}
+	fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+	int arg = 1, event;
+	if(argc > arg && strcmp(argv[arg], "-p") == 0)
+	{
+		arg++;
+		counters = PerfCounters_create();
+		if(counters != NULL && counters->available == 0)
+			fprintf(stderr, "no performance counters available (see "
+					"/proc/sys/kernel/perf_event_paranoid), timing only\n");
+	}
+	size_t maxSize = argc > arg ? (size_t)atol(argv[arg]) : BENCHMARK_MAX_SIZE;
+	size_t n;
+	FILE* output = fopen(BENCHMARK_OUTPUT, "w");
+	if(output == NULL)
+		perror(BENCHMARK_OUTPUT);
+	else
+	{
+		fprintf(output, "# container\ttype\toperation\tsize\toperations\tns_per_op\tbytes_per_element");
+		for(event = 0; counters != NULL && event < PERF_EVENT_COUNT; event++)
+			fprintf(output, "\t%s_per_op", PerfCounters_eventNames[event]);
+		fprintf(output, "\n");
+	}
+	printf("%-26s %-12s %-13s %9s %12s %10s", "container", "type", "operation",
+			"size", "ns/op", "bytes/elem");
+	for(event = 0; counters != NULL && event < PERF_EVENT_COUNT; event++)
+		printf(" %13s", PerfCounters_eventNames[event]);
+	printf("\n");
+	for(n = 10; n <= maxSize; n *= 10)
+	{
+		Benchmark_run(output, "DoublyLinkedList", "long double", Benchmark_doublyLinkedList, n);
+		Benchmark_run(output, "TypedDoublyLinkedList", "int", Benchmark_IntList, n);
+		Benchmark_run(output, "TypedDoublyLinkedList", "double", Benchmark_DoubleList, n);
+		Benchmark_run(output, "TypedDoublyLinkedList", "record32", Benchmark_RecordList, n);
+		Benchmark_run(output, "CircularDoublyLinkedList", "long double",
+				Benchmark_circularDoublyLinkedList, n);
+		Benchmark_run(output, "CircularBuffer", "long double", Benchmark_circularBuffer, n);
+		Benchmark_run(output, "DoubleStack", "double", Benchmark_doubleStack, n);
+		Benchmark_run(output, "Deque", "long double", Benchmark_deque, n);
+	}
+	if(output != NULL) fclose(output);
+	PerfCounters_free(counters);
+	return 0;
+}
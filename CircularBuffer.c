@@ -0,0 +1,189 @@
+/*
+ * CircularBuffer - A circular list of E's in a power-of-2 ring that doubles
+ * when full, with the CircularDoublyLinkedList interface and no allocation
+ * per entry. E is generic and can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "CircularBuffer.h"
+
+/*
+ * Returns the slot of the entry offset places after the handle
+ */
+static size_t CircularBuffer_slot(CircularBuffer* cb, size_t offset)
+{
+	return (cb->handle + offset) & (cb->capacity - 1);
+}
+/*
+ * Moves the entries into a ring of capacity slots, a power of 2 at least
+ * cb->elements, with the handle at slot 0. Nonzero on failure.
+ */
+static int CircularBuffer_resize(CircularBuffer* cb, size_t capacity)
+{
+	E* values = (E*)malloc(capacity * sizeof(E));
+	if(values == NULL) return 1;
+	if(cb->elements > 0)
+	{
+		// the entries are at most two runs: handle to the end of the ring,
+		// then the start of the ring
+		size_t first = cb->capacity - cb->handle;
+		if(first > cb->elements) first = cb->elements;
+		memcpy(values, cb->values + cb->handle, first * sizeof(E));
+		memcpy(values + first, cb->values, (cb->elements - first) * sizeof(E));
+	}
+	free(cb->values);
+	cb->values = values;
+	cb->capacity = capacity;
+	cb->handle = 0;
+	return 0;
+}
+/*
+ * Allocates an empty CircularBuffer with room for capacity entries.
+ * Returns NULL on failure.
+ */
+CircularBuffer* CircularBuffer_create(size_t capacity)
+{
+	CircularBuffer* cb = (CircularBuffer*)malloc(sizeof(CircularBuffer));
+	if(cb == NULL) return NULL;
+	cb->values = NULL;
+	cb->capacity = 0;
+	cb->handle = 0;
+	cb->elements = 0;
+	if(CircularBuffer_reserve(cb, capacity ? capacity : CIRCULARBUFFER_SIZE))
+	{
+		free(cb);
+		return NULL;
+	}
+	return cb;
+}
+/*
+ * Deallocates a CircularBuffer
+ */
+void CircularBuffer_free(CircularBuffer* cb)
+{
+	if(cb == NULL) return;
+	free(cb->values);
+	free(cb);
+}
+/*
+ * Makes room for capacity entries, rounding up to a power of 2.
+ * Nonzero on failure.
+ */
+int CircularBuffer_reserve(CircularBuffer* cb, size_t capacity)
+{
+	if(cb == NULL) return 1;
+	if(capacity <= cb->capacity) return 0;
+	size_t rounded = 1;
+	while(rounded < capacity)
+	{
+		if(rounded > ((size_t)-1 / sizeof(E)) / 2) return 1;
+		rounded <<= 1;
+	}
+	return CircularBuffer_resize(cb, rounded);
+}
+/*
+ * Adds an entry to the tail of the buffer, doubling the ring when it's full
+ */
+int CircularBuffer_addEntry(CircularBuffer* cb, E data)
+{
+	if(cb == NULL) return 1;
+	if(cb->elements == cb->capacity &&
+			CircularBuffer_reserve(cb, cb->capacity ? cb->capacity * 2 : CIRCULARBUFFER_SIZE))
+		return 1;
+	cb->values[CircularBuffer_slot(cb, cb->elements)] = data;
+	cb->elements++;
+	return 0;
+}
+/*
+ * Removes whichever value is currently the handle from the buffer.
+ * Nonzero if cb is empty or null.
+ */
+int CircularBuffer_removeEntry(CircularBuffer* cb)
+{
+	if(cb == NULL || cb->elements == 0) return 1;
+	cb->handle = CircularBuffer_slot(cb, 1);
+	cb->elements--;
+	return 0;
+}
+/*
+ * Makes the entry after the handle the new handle. Unless the ring is full,
+ * that means moving the old handle into the free slot after the tail.
+ */
+void CircularBuffer_rotateNext(CircularBuffer* cb)
+{
+	if(cb == NULL || cb->elements < 2) return;
+	if(cb->elements < cb->capacity)
+		cb->values[CircularBuffer_slot(cb, cb->elements)] = cb->values[cb->handle];
+	cb->handle = CircularBuffer_slot(cb, 1);
+}
+/*
+ * Makes the tail the new handle, moving it into the free slot before the
+ * handle unless the ring is full.
+ */
+void CircularBuffer_rotatePrev(CircularBuffer* cb)
+{
+	if(cb == NULL || cb->elements < 2) return;
+	size_t tail = CircularBuffer_slot(cb, cb->elements - 1);
+	cb->handle = CircularBuffer_slot(cb, cb->capacity - 1);
+	cb->values[cb->handle] = cb->values[tail];
+}
+/*
+ * Retrieves a cursor at the handle
+ */
+CBCursor CircularBuffer_getHandle(CircularBuffer* cb)
+{
+	CBCursor cursor = { cb, 0 };
+	return cursor;
+}
+/*
+ * Retrieves a cursor at the entry after cursor
+ */
+CBCursor CircularBuffer_getNext(CBCursor cursor)
+{
+	if(cursor.buffer == NULL || cursor.buffer->elements == 0) return cursor;
+	cursor.offset = cursor.offset + 1 < cursor.buffer->elements ? cursor.offset + 1 : 0;
+	return cursor;
+}
+/*
+ * Retrieves a cursor at the entry before cursor
+ */
+CBCursor CircularBuffer_getPrev(CBCursor cursor)
+{
+	if(cursor.buffer == NULL || cursor.buffer->elements == 0) return cursor;
+	cursor.offset = cursor.offset > 0 ? cursor.offset - 1 : cursor.buffer->elements - 1;
+	return cursor;
+}
+/*
+ * Retrieves the data at cursor
+ */
+E CircularBuffer_getData(CBCursor cursor)
+{
+	assert(cursor.buffer != NULL && cursor.offset < cursor.buffer->elements);
+	return cursor.buffer->values[CircularBuffer_slot(cursor.buffer, cursor.offset)];
+}
+/*
+ * Sets the data at cursor. Nonzero on failure.
+ */
+int CircularBuffer_setData(CBCursor cursor, E data)
+{
+	if(cursor.buffer == NULL || cursor.offset >= cursor.buffer->elements) return 1;
+	cursor.buffer->values[CircularBuffer_slot(cursor.buffer, cursor.offset)] = data;
+	return 0;
+}
+/*
+ * Returns 1 if both cursors point at the same entry and 0 if not.
+ */
+int CircularBuffer_equals(CBCursor cursor1, CBCursor cursor2)
+{
+	return cursor1.buffer == cursor2.buffer && cursor1.offset == cursor2.offset;
+}
+/*
+ * Returns the number of entries currently in the buffer.
+ */
+size_t CircularBuffer_getElements(CircularBuffer* cb)
+{
+	if(cb == NULL) return 0;
+	return cb->elements;
+}
@@ -0,0 +1,131 @@
+/*
+ * CircularBuffer - A CircularDoublyLinkedList kept in one growable array
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef CIRCULARBUFFER_H
+#define CIRCULARBUFFER_H
+
+#include <stddef.h>
+
+/*
+ * E's are long doubles by default, see CircularDoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing CircularBuffer.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+#define CIRCULARBUFFER_SIZE 16	// Default initial capacity, a power of 2
+
+/*
+ * Traverses the buffer once around, starting at the handle
+ * Usage:
+ * CBCursor cursor;
+ * CB_TRAVERSAL(buffer, cursor)
+ * {
+ *      [this code gets executed buffer->elements times]
+ *      [and CircularBuffer_getData(cursor) is the current element]
+ * }
+ */
+#define CB_TRAVERSAL(CB, CURSOR)										\
+	for(CURSOR = CircularBuffer_getHandle(CB);							\
+			CURSOR.offset < (CB)->elements; CURSOR.offset++)
+
+/*
+ * A CircularBuffer is a circular list like a CircularDoublyLinkedList: a
+ * handle, the entries after it, and the last entry wrapping back around to
+ * the handle. It's stored in a ring of capacity slots (a power of 2) starting
+ * at values[handle], so nothing is allocated per entry, walking it reads
+ * memory in order, and the ring doubles when it fills up.
+ * Adding at the tail, removing the handle and rotating the handle either
+ * way are all O(1).
+ */
+typedef struct
+{
+	E* values;			// the ring
+	size_t capacity;	// room in values, a power of 2
+	size_t handle;		// slot of the handle
+	size_t elements;	// number of entries
+}CircularBuffer;
+
+/*
+ * A CBCursor stands in for a CDLLNode: a position in a CircularBuffer,
+ * counted in entries after the handle. Adding entries keeps cursors valid,
+ * while removing or rotating shifts what they point at.
+ */
+typedef struct
+{
+	CircularBuffer* buffer;
+	size_t offset;
+}CBCursor;
+
+/*
+ * Allocates an empty CircularBuffer with room for capacity entries
+ * (CIRCULARBUFFER_SIZE if capacity is 0), rounded up to a power of 2.
+ * Returns NULL on failure.
+ */
+CircularBuffer* CircularBuffer_create(size_t capacity);
+/*
+ * Deallocates a CircularBuffer.
+ */
+void CircularBuffer_free(CircularBuffer* cb);
+/*
+ * Makes room for capacity entries in total. Nonzero on failure.
+ */
+int CircularBuffer_reserve(CircularBuffer* cb, size_t capacity);
+/*
+ * Adds an entry to the tail of the buffer, just before the handle.
+ * Nonzero on failure.
+ */
+int CircularBuffer_addEntry(CircularBuffer* cb, E data);
+/*
+ * Removes the handle from the buffer, making the entry after it the new
+ * handle. Nonzero if the buffer is empty.
+ */
+int CircularBuffer_removeEntry(CircularBuffer* cb);
+/*
+ * Makes the entry after the handle the new handle.
+ */
+void CircularBuffer_rotateNext(CircularBuffer* cb);
+/*
+ * Makes the entry before the handle (the tail) the new handle.
+ */
+void CircularBuffer_rotatePrev(CircularBuffer* cb);
+/*
+ * Retrieves a cursor at the handle.
+ */
+CBCursor CircularBuffer_getHandle(CircularBuffer* cb);
+/*
+ * Retrieves a cursor at the entry after cursor, wrapping around from the
+ * tail to the handle.
+ */
+CBCursor CircularBuffer_getNext(CBCursor cursor);
+/*
+ * Retrieves a cursor at the entry before cursor, wrapping around from the
+ * handle to the tail.
+ */
+CBCursor CircularBuffer_getPrev(CBCursor cursor);
+/*
+ * Retrieves the data at cursor, which must be in the buffer.
+ */
+E CircularBuffer_getData(CBCursor cursor);
+/*
+ * Sets the data at cursor. Nonzero if cursor isn't in the buffer.
+ */
+int CircularBuffer_setData(CBCursor cursor, E data);
+/*
+ * Returns 1 if both cursors point at the same entry and 0 if not.
+ */
+int CircularBuffer_equals(CBCursor cursor1, CBCursor cursor2);
+/*
+ * Returns the number of entries currently in the buffer.
+ */
+size_t CircularBuffer_getElements(CircularBuffer* cb);
+
+#endif
@@ -7,49 +7,42 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "CircularDoublyLinkedList.h"
 
 /*
- * E's are long doubles because they allocate the most space of all primitive
- * types, therefore ensuring enough space for any other type that could be
- * cast into it.
+ * Allocates a node, counting the allocation. Returns NULL on failure.
  */
-typedef long double E;
-
-/*
- * A CDLLNode (CircularDoublyLinkedListNode) consists of a piece of data of type E
- * (which is really usually some other type cast into an E, and can also be a
- * pointer) and pointers to the next and previous DLLNodes in the list (NULL
- * if the node is a handle or tail node.
- */
-typedef struct
+static CDLLNode* CircularDoublyLinkedList_allocNode(CircularDoublyLinkedList* cdll)
 {
-	E data;
-	void* next;
-	void* prev;
-}CDLLNode;
-
+	CDLLNode* node = (CDLLNode*)malloc(sizeof(CDLLNode));
+	CONTAINER_STATS_ADD(cdll, allocations, 1);
+	if(node == NULL) CONTAINER_STATS_ADD(cdll, overflows, 1);
+	return node;
+}
 /*
- * A CircularDoublyLinkedList is just a handle Node, a pointer to a tail node, and an int
- * representing the amount of elements in the list. The handle node is not a
- * pointer because it's value never changes unless the list is emptied.
+ * Makes a node holding data the only one of an empty List.
  */
-typedef struct
+static void CircularDoublyLinkedList_firstNode(CircularDoublyLinkedList* cdll, E data)
 {
-	CDLLNode* handle;
-	int elements;
-}CircularDoublyLinkedList;
-
+	CDLLNode* node = CircularDoublyLinkedList_allocNode(cdll);
+	if(node == NULL) return;
+	(*cdll).elements = 1;
+	(*cdll).handle = node;
+	(*node).data = data;
+	(*node).prev = node;
+	(*node).next = node;
+	CONTAINER_STATS_PEAK(cdll, 1);
+}
 /*
  * Initializes List and creates first node.
  */
 void CircularDoublyLinkedList_initialize(CircularDoublyLinkedList* cdll, E data)
 {
 	if(cdll == NULL) return;
-	(*cdll).elements = 1;
-	(*cdll).handle = (CDLLNode*)malloc(sizeof(CDLLNode));
-	(*(*cdll).handle).data = data;
-	(*(*cdll).handle).prev = (*cdll).handle;
-	(*(*cdll).handle).next = (*cdll).handle;
+	CONTAINER_STATS_RESET(cdll);
+	(*cdll).elements = 0;
+	(*cdll).handle = NULL;
+	CircularDoublyLinkedList_firstNode(cdll, data);
 }
 /*
  * Initializes an empty List.
@@ -57,10 +50,9 @@ void CircularDoublyLinkedList_initialize(CircularDoublyLinkedList* cdll, E data)
 void CircularDoublyLinkedList_init(CircularDoublyLinkedList* cdll)
 {
 	if(cdll == NULL) return;
+	CONTAINER_STATS_RESET(cdll);
 	(*cdll).elements = 0;
-	(*(*cdll).handle).data = (E)0;
-	(*(*cdll).handle).prev = NULL;
-	(*(*cdll).handle).next = NULL;
+	(*cdll).handle = NULL;
 }
 /*
  * Adds an entry to the List.
@@ -69,26 +61,30 @@ void CircularDoublyLinkedList_addEntry(CircularDoublyLinkedList* cdll, E data)
 {
 	if(cdll == NULL) return;
 	if((*cdll).elements == 0)
-		CircularDoublyLinkedList_initialize(cdll, data);
+		CircularDoublyLinkedList_firstNode(cdll, data);
 	else if((*cdll).elements == 1)
 	{
-		CDLLNode* tmpNode = malloc(sizeof(CDLLNode));
+		CDLLNode* tmpNode = CircularDoublyLinkedList_allocNode(cdll);
+		if(tmpNode == NULL) return;
 		(*tmpNode).data = data;
 		(*tmpNode).next = (*cdll).handle;
 		(*tmpNode).prev = (*cdll).handle;
 		(*(*cdll).handle).next = tmpNode;
 		(*(*cdll).handle).prev = tmpNode;
 		(*cdll).elements++;
+		CONTAINER_STATS_PEAK(cdll, (*cdll).elements);
 	}
 	else
 	{
-		CDLLNode* tmpNode = malloc(sizeof(CDLLNode));
+		CDLLNode* tmpNode = CircularDoublyLinkedList_allocNode(cdll);
+		if(tmpNode == NULL) return;
 		(*tmpNode).data = data;
 		(*tmpNode).next = (*cdll).handle;
 		(*tmpNode).prev = (*(*cdll).handle).prev;
 		(*(*cdll).handle).prev = tmpNode;
 		(*(CDLLNode*)(*tmpNode).prev).next = tmpNode;
 		(*cdll).elements++;
+		CONTAINER_STATS_PEAK(cdll, (*cdll).elements);
 	}
 	return;
 }
@@ -101,11 +97,16 @@ int CircularDoublyLinkedList_removeEntry(CircularDoublyLinkedList* cdll)
 	if(cdll == NULL)
 		return 1;
 	if((*cdll).elements == 0)
+	{
+		CONTAINER_STATS_ADD(cdll, underflows, 1);
 		return 1;
+	}
+	CONTAINER_STATS_ADD(cdll, frees, 1);
 	if((*cdll).elements == 1)
 	{
 		free((*cdll).handle);
-		CircularDoublyLinkedList_init(cdll);
+		(*cdll).elements = 0;
+		(*cdll).handle = NULL;
 		return 0;
 	}
 	(*(CDLLNode*)(*(*cdll).handle).next).prev = (*(*cdll).handle).prev;
@@ -117,12 +118,17 @@ int CircularDoublyLinkedList_removeEntry(CircularDoublyLinkedList* cdll)
 	return 0;
 }
 /*
- * Retrieves the handle node. Returns 0 if cdll is null.
+ * Retrieves a copy of the handle node. Returns a zeroed node if cdll is null
+ * or empty.
  */
-CDLLNode* CircularDoublyLinkedList_getHandle(CircularDoublyLinkedList* cdll)
+CDLLNode CircularDoublyLinkedList_getHandle(CircularDoublyLinkedList* cdll)
 {
-	if(cdll == NULL) return NULL;
-	return (*cdll).handle;
+	if(cdll == NULL || (*cdll).handle == NULL)
+	{
+		CDLLNode empty = { (E)0, NULL, NULL };
+		return empty;
+	}
+	return *(*cdll).handle;
 }
 /*
  * Retrives the node after the current node. Returns the parameter if the
@@ -203,3 +209,20 @@ int CircularDoublyLinkedList_getElements(CircularDoublyLinkedList* cdll)
 	if(cdll == NULL) return 0;
 	return (*cdll).elements;
 }
+/*
+ * Copies the counters of cdll into stats. Nonzero if they're compiled out.
+ */
+int CircularDoublyLinkedList_getStats(CircularDoublyLinkedList* cdll, ContainerStats* stats)
+{
+	if(cdll == NULL || stats == NULL) return 1;
+	return CONTAINER_STATS_GET(cdll, stats);
+}
+/*
+ * Zeroes the counters of cdll
+ */
+void CircularDoublyLinkedList_resetStats(CircularDoublyLinkedList* cdll)
+{
+	if(cdll == NULL) return;
+	CONTAINER_STATS_RESET(cdll);
+	CONTAINER_STATS_PEAK(cdll, (*cdll).elements);
+}
@@ -6,33 +6,59 @@
  */
 
 /*
- * E's are long doubles because they allocate the most space of all primitive
- * types, therefore ensuring enough space for any other type that could be
- * cast into it.
+ * E's are long doubles by default because they allocate the most space of
+ * all primitive types, therefore ensuring enough space for any other type
+ * that could be cast into it.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing CircularDoublyLinkedList.h
  */
-typedef long double E;
+#include "ContainerStats.h"
+
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+/*
+ * Traverses the list once around, starting at the handle
+ * Usage:
+ * CDLLNode* handle;
+ * int i;
+ * CDLL_TRAVERSAL(list, handle, i)
+ * {
+ *      [this code gets executed list->elements times]
+ *      [and handle points to the current node]
+ * }
+ */
+#define CDLL_TRAVERSAL(CDLL, CDLLNODE, I)								\
+	for(CDLLNODE = (CDLL)->handle, I = 0; I < (CDLL)->elements;		\
+			CDLLNODE = CDLLNODE->next, I++)
+
 /*
  * A CDLLNode (CircularDoublyLinkedListNode) consists of a piece of data of type E
  * (which is really usually some other type cast into an E, and can also be a
- * pointer) and pointers to the next and previous CDLLNodes in the list (NULL
- * if the node is a head or tail node.
+ * pointer) and pointers to the next and previous CDLLNodes in the list. The
+ * list is circular, so the tail's next node is the handle and the handle's
+ * previous node is the tail.
  */
-typedef struct
+typedef struct CDLLNode
 {
 	E data;
-	void* next;
-	void* prev;
+	struct CDLLNode* next;
+	struct CDLLNode* prev;
 }CDLLNode;
 /*
- * A CircularDoublyLinkedList is just a head Node, a pointer to a tail node, and an int
- * representing the amount of elements in the list. The head node is not a
- * pointer because it's value never changes unless the list is emptied.
+ * A CircularDoublyLinkedList is just a pointer to its handle node (NULL if
+ * the list is empty) and an int representing the amount of elements in the
+ * list.
  */
 typedef struct
 {
-	CDLLNode head;	// the head isn't a pointer, but the tail is,
-	CDLLNode* tail;	// because the head is static and the tail is dynamic
+	CDLLNode* handle;
 	int elements;
+	CONTAINER_STATS_MEMBER		// only with -DCONTAINER_STATS, see ContainerStats.h
 }CircularDoublyLinkedList;
 
 /*
@@ -71,7 +97,7 @@ void CircularDoublyLinkedList_addEntry(CircularDoublyLinkedList* dll, E data);
  */
 int CircularDoublyLinkedList_removeEntry(CircularDoublyLinkedList* dll);
 /*
- * Retrieves the head node.
+ * Retrieves a copy of the handle node (a zeroed node if dll is empty).
  */
 CDLLNode CircularDoublyLinkedList_getHandle(CircularDoublyLinkedList* dll);
 /*
@@ -82,3 +108,80 @@ int CircularDoublyLinkedList_equals(CDLLNode node1, CDLLNode node2);
  * Returns the number of elements currently in the list.
  */
 int CircularDoublyLinkedList_getElements(CircularDoublyLinkedList* dll);
+/*
+ * Copies what dll has counted since it was initialized or last reset into
+ * stats. Nonzero (and stats zeroed) if the program wasn't compiled with
+ * CONTAINER_STATS.
+ */
+int CircularDoublyLinkedList_getStats(CircularDoublyLinkedList* dll, ContainerStats* stats);
+/*
+ * Zeroes the counters of dll, with peakSize starting over from its size.
+ */
+void CircularDoublyLinkedList_resetStats(CircularDoublyLinkedList* dll);
+
+/*
+ * Iterators are plain node pointers, so walking a list with them costs one
+ * pointer chase per step instead of a copy of the node, and the data can be
+ * changed in place through CircularDoublyLinkedList_ref, with no need for
+ * setData to find the real node. There's no end iterator: stepping from the
+ * tail comes back to begin.
+ * Usage:
+ * CDLLIterator it = CircularDoublyLinkedList_begin(list);
+ * if(it != NULL) do
+ * {
+ *      [CircularDoublyLinkedList_deref(it) is the current element]
+ *      it = CircularDoublyLinkedList_next(it);
+ * }while(it != CircularDoublyLinkedList_begin(list));
+ */
+typedef CDLLNode* CDLLIterator;
+typedef const CDLLNode* CDLLConstIterator;
+/*
+ * Returns an iterator at the handle, or NULL if dll is empty.
+ */
+static inline CDLLIterator CircularDoublyLinkedList_begin(CircularDoublyLinkedList* dll)
+{
+	return dll->handle;
+}
+/*
+ * Returns an iterator at the node after it.
+ */
+static inline CDLLIterator CircularDoublyLinkedList_next(CDLLIterator it)
+{
+	return it->next;
+}
+/*
+ * Returns an iterator at the node before it.
+ */
+static inline CDLLIterator CircularDoublyLinkedList_prev(CDLLIterator it)
+{
+	return it->prev;
+}
+/*
+ * Returns a pointer to the data at it, to read or change in place.
+ */
+static inline E* CircularDoublyLinkedList_ref(CDLLIterator it)
+{
+	return &it->data;
+}
+/*
+ * Read-only versions of the above, for const lists.
+ */
+static inline CDLLConstIterator CircularDoublyLinkedList_cbegin(const CircularDoublyLinkedList* dll)
+{
+	return dll->handle;
+}
+static inline CDLLConstIterator CircularDoublyLinkedList_cnext(CDLLConstIterator it)
+{
+	return it->next;
+}
+static inline CDLLConstIterator CircularDoublyLinkedList_cprev(CDLLConstIterator it)
+{
+	return it->prev;
+}
+/*
+ * Returns the data at it, which can be either kind of iterator.
+ */
+static inline E CircularDoublyLinkedList_deref(CDLLConstIterator it)
+{
+	return it->data;
+}
@@ -0,0 +1,298 @@
+/*
+ * CompactList - A doubly-linked list of values of type E, which are generic
+ * and can be specified explicitly by calling
+ * #define GENERICS [type]
+ * Nodes are slots in parallel arrays linked by 32-bit slot numbers, see
+ * CompactList.h.
+ */
+#include <stdlib.h>
+#include <assert.h>
+#include "CompactList.h"
+
+#define CL_REMOVED 0xFFFFFFFEu	// prev of a slot on the free list
+#define CL_MAX_NODES CL_REMOVED	// slot numbers stay below both markers
+
+/*
+ * Returns 1 if handle names a node that's in the list, 0 if not.
+ */
+static int CompactList_valid(const CompactList* cl, CLHandle handle)
+{
+	return handle < cl->used && cl->prev[handle] != CL_REMOVED;
+}
+/*
+ * Resizes all three arrays to capacity slots. Nonzero on failure, in which
+ * case the list is unchanged.
+ */
+static int CompactList_resize(CompactList* cl, uint32_t capacity)
+{
+	E* values = (E*)realloc(cl->values, capacity * sizeof(E));
+	if(values == NULL) return 1;
+	cl->values = values;
+	CLHandle* next = (CLHandle*)realloc(cl->next, capacity * sizeof(CLHandle));
+	if(next == NULL) return 1;
+	cl->next = next;
+	CLHandle* prev = (CLHandle*)realloc(cl->prev, capacity * sizeof(CLHandle));
+	if(prev == NULL) return 1;
+	cl->prev = prev;
+	// a bigger values or next array that goes unused is harmless
+	cl->capacity = capacity;
+	return 0;
+}
+/*
+ * Takes a slot off the free list, or a fresh one, doubling the arrays if
+ * needed, and stores data in it. Returns CL_NULL on failure.
+ */
+static CLHandle CompactList_allocSlot(CompactList* cl, E data)
+{
+	CLHandle slot = cl->freeList;
+	if(slot != CL_NULL)
+		cl->freeList = cl->next[slot];
+	else
+	{
+		if(cl->used == CL_MAX_NODES) return CL_NULL;
+		if(cl->used == cl->capacity)
+		{
+			size_t capacity = cl->capacity ? (size_t)cl->capacity * 2 : COMPACTLIST_SIZE;
+			if(CompactList_reserve(cl, capacity < CL_MAX_NODES ? capacity : CL_MAX_NODES))
+				return CL_NULL;
+		}
+		slot = cl->used++;
+	}
+	cl->values[slot] = data;
+	return slot;
+}
+/*
+ * Puts a slot on the free list
+ */
+static void CompactList_freeSlot(CompactList* cl, CLHandle slot)
+{
+	cl->prev[slot] = CL_REMOVED;
+	cl->next[slot] = cl->freeList;
+	cl->freeList = slot;
+}
+/*
+ * Makes slot the only node of the empty list
+ */
+static CLHandle CompactList_first(CompactList* cl, CLHandle slot)
+{
+	cl->next[slot] = CL_NULL;
+	cl->prev[slot] = CL_NULL;
+	cl->head = slot;
+	cl->tail = slot;
+	cl->size = 1;
+	return slot;
+}
+/*
+ * Allocates an empty CompactList with room for capacity nodes
+ */
+CompactList* CompactList_create(size_t capacity)
+{
+	CompactList* cl = (CompactList*)malloc(sizeof(CompactList));
+	if(cl == NULL) return NULL;
+	cl->values = NULL;
+	cl->next = NULL;
+	cl->prev = NULL;
+	cl->head = CL_NULL;
+	cl->tail = CL_NULL;
+	cl->freeList = CL_NULL;
+	cl->used = 0;
+	cl->capacity = 0;
+	cl->size = 0;
+	if(CompactList_reserve(cl, capacity ? capacity : COMPACTLIST_SIZE))
+	{
+		CompactList_free(cl);
+		return NULL;
+	}
+	return cl;
+}
+/*
+ * Deallocates a CompactList
+ */
+void CompactList_free(CompactList* cl)
+{
+	if(cl == NULL) return;
+	free(cl->values);
+	free(cl->next);
+	free(cl->prev);
+	free(cl);
+}
+/*
+ * Makes room for capacity nodes. Nonzero on failure.
+ */
+int CompactList_reserve(CompactList* cl, size_t capacity)
+{
+	if(cl == NULL || capacity > CL_MAX_NODES) return 1;
+	if(capacity <= cl->capacity) return 0;
+	return CompactList_resize(cl, (uint32_t)capacity);
+}
+/*
+ * Adds an entry to the tail end of the list. Returns its handle, or
+ * CL_NULL on failure.
+ */
+CLHandle CompactList_pushTail(CompactList* cl, E data)
+{
+	if(cl->size == 0)
+	{
+		CLHandle slot = CompactList_allocSlot(cl, data);
+		return slot == CL_NULL ? CL_NULL : CompactList_first(cl, slot);
+	}
+	return CompactList_insertAfter(cl, cl->tail, data);
+}
+/*
+ * Adds an entry to the head end of the list. Returns its handle, or
+ * CL_NULL on failure.
+ */
+CLHandle CompactList_pushHead(CompactList* cl, E data)
+{
+	if(cl->size == 0)
+	{
+		CLHandle slot = CompactList_allocSlot(cl, data);
+		return slot == CL_NULL ? CL_NULL : CompactList_first(cl, slot);
+	}
+	return CompactList_insertBefore(cl, cl->head, data);
+}
+/*
+ * Pops and returns the tail off the list
+ */
+E CompactList_popTail(CompactList* cl)
+{
+	assert(cl->size > 0);
+	E data = cl->values[cl->tail];
+	CompactList_remove(cl, cl->tail);
+	return data;
+}
+/*
+ * Pops and returns the head off the list
+ */
+E CompactList_popHead(CompactList* cl)
+{
+	assert(cl->size > 0);
+	E data = cl->values[cl->head];
+	CompactList_remove(cl, cl->head);
+	return data;
+}
+/*
+ * Inserts data right after handle. Returns the new handle, or CL_NULL on
+ * failure.
+ */
+CLHandle CompactList_insertAfter(CompactList* cl, CLHandle handle, E data)
+{
+	if(!CompactList_valid(cl, handle)) return CL_NULL;
+	CLHandle slot = CompactList_allocSlot(cl, data);
+	if(slot == CL_NULL) return CL_NULL;
+	CLHandle after = cl->next[handle];
+	cl->prev[slot] = handle;
+	cl->next[slot] = after;
+	if(after != CL_NULL)
+		cl->prev[after] = slot;
+	else
+		cl->tail = slot;
+	cl->next[handle] = slot;
+	cl->size++;
+	return slot;
+}
+/*
+ * Inserts data right before handle. Returns the new handle, or CL_NULL on
+ * failure.
+ */
+CLHandle CompactList_insertBefore(CompactList* cl, CLHandle handle, E data)
+{
+	if(!CompactList_valid(cl, handle)) return CL_NULL;
+	CLHandle slot = CompactList_allocSlot(cl, data);
+	if(slot == CL_NULL) return CL_NULL;
+	CLHandle before = cl->prev[handle];
+	cl->next[slot] = handle;
+	cl->prev[slot] = before;
+	if(before != CL_NULL)
+		cl->next[before] = slot;
+	else
+		cl->head = slot;
+	cl->prev[handle] = slot;
+	cl->size++;
+	return slot;
+}
+/*
+ * Removes the node at handle from the list. Nonzero on failure.
+ */
+int CompactList_remove(CompactList* cl, CLHandle handle)
+{
+	if(cl == NULL || !CompactList_valid(cl, handle)) return 1;
+	CLHandle before = cl->prev[handle];
+	CLHandle after = cl->next[handle];
+	if(before != CL_NULL)
+		cl->next[before] = after;
+	else
+		cl->head = after;
+	if(after != CL_NULL)
+		cl->prev[after] = before;
+	else
+		cl->tail = before;
+	cl->size--;
+	CompactList_freeSlot(cl, handle);
+	return 0;
+}
+/*
+ * Retrieves the handle of the head
+ */
+CLHandle CompactList_getHead(const CompactList* cl)
+{
+	return cl->head;
+}
+/*
+ * Retrieves the handle of the tail
+ */
+CLHandle CompactList_getTail(const CompactList* cl)
+{
+	return cl->tail;
+}
+/*
+ * Retrieves the handle after handle
+ */
+CLHandle CompactList_getNext(const CompactList* cl, CLHandle handle)
+{
+	assert(CompactList_valid(cl, handle));
+	return cl->next[handle];
+}
+/*
+ * Retrieves the handle before handle
+ */
+CLHandle CompactList_getPrev(const CompactList* cl, CLHandle handle)
+{
+	assert(CompactList_valid(cl, handle));
+	return cl->prev[handle];
+}
+/*
+ * Retrieves the data at handle
+ */
+E CompactList_getData(const CompactList* cl, CLHandle handle)
+{
+	assert(CompactList_valid(cl, handle));
+	return cl->values[handle];
+}
+/*
+ * Sets the data at handle. Nonzero on failure.
+ */
+int CompactList_setData(CompactList* cl, CLHandle handle, E data)
+{
+	if(cl == NULL || !CompactList_valid(cl, handle)) return 1;
+	cl->values[handle] = data;
+	return 0;
+}
+/*
+ * Returns the number of elements in the list
+ */
+size_t CompactList_getSize(const CompactList* cl)
+{
+	return cl->size;
+}
+/*
+ * Returns the handle of the first node holding value, or CL_NULL
+ */
+CLHandle CompactList_find(const CompactList* cl, E value)
+{
+	CLHandle handle;
+	CL_TRAVERSAL(cl, handle)
+		if(cl->values[handle] == value)
+			return handle;
+	return CL_NULL;
+}
@@ -0,0 +1,164 @@
+/*
+ * CompactList - A DoublyLinkedList with 32-bit links and no per-node
+ * allocation, for very large lists
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef COMPACTLIST_H
+#define COMPACTLIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing CompactList.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+#define CL_NULL 0xFFFFFFFFu		// handle of no node
+#define COMPACTLIST_SIZE 16		// Default initial capacity
+
+/*
+ * Traverses the list from head to tail
+ * Usage:
+ * CLHandle handle;
+ * CL_TRAVERSAL(list, handle)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and CompactList_getData(list, handle) is the current element]
+ * }
+ */
+#define CL_TRAVERSAL(CL, HANDLE)										\
+	for(HANDLE = (CL)->head; HANDLE != CL_NULL; HANDLE = (CL)->next[HANDLE])
+
+/*
+ * Traverses the list from tail to head
+ * Usage:
+ * CLHandle handle;
+ * CL_REVERSE_TRAVERSAL(list, handle)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and CompactList_getData(list, handle) is the current element]
+ * }
+ */
+#define CL_REVERSE_TRAVERSAL(CL, HANDLE)								\
+	for(HANDLE = (CL)->tail; HANDLE != CL_NULL; HANDLE = (CL)->prev[HANDLE])
+
+/*
+ * A CLHandle names a node of a CompactList the way a DLLNode* does in a
+ * DoublyLinkedList. It stays valid until the node is removed, even when
+ * the list grows.
+ */
+typedef uint32_t CLHandle;
+
+/*
+ * A CompactList is a doubly-linked list whose nodes are slots in three
+ * parallel arrays: values, and the next and prev links as 32-bit slot
+ * numbers. Nodes don't point back at their list, so every call takes the
+ * list explicitly. Per element that's sizeof(E) + 8 bytes, e.g. 24 for long
+ * doubles and 16 for doubles, against 48 and 32 for a DLLNode before
+ * malloc's own overhead.
+ * Removed slots are chained through next and reused first, and the arrays
+ * double when they fill up, up to CL_NULL - 1 nodes.
+ */
+typedef struct
+{
+	E* values;
+	CLHandle* next;
+	CLHandle* prev;
+	CLHandle head;
+	CLHandle tail;
+	CLHandle freeList;	// first removed slot, chained through next
+	uint32_t used;		// slots ever handed out
+	uint32_t capacity;	// room in the arrays
+	size_t size;
+}CompactList;
+
+/*
+ * Allocates an empty CompactList with room for capacity nodes
+ * (COMPACTLIST_SIZE if capacity is 0). Returns NULL on failure.
+ */
+CompactList* CompactList_create(size_t capacity);
+/*
+ * Deallocates a CompactList.
+ */
+void CompactList_free(CompactList* cl);
+/*
+ * Makes room for capacity nodes in total. Nonzero on failure.
+ */
+int CompactList_reserve(CompactList* cl, size_t capacity);
+/*
+ * Adds an entry to the tail end of the list. Returns its handle, or
+ * CL_NULL on failure.
+ */
+CLHandle CompactList_pushTail(CompactList* cl, E data);
+/*
+ * Adds an entry to the head end of the list. Returns its handle, or
+ * CL_NULL on failure.
+ */
+CLHandle CompactList_pushHead(CompactList* cl, E data);
+/*
+ * Pops and returns the tail off the list, which must not be empty.
+ */
+E CompactList_popTail(CompactList* cl);
+/*
+ * Pops and returns the head off the list, which must not be empty.
+ */
+E CompactList_popHead(CompactList* cl);
+/*
+ * Inserts data right after handle. Returns the new handle, or CL_NULL on
+ * failure.
+ */
+CLHandle CompactList_insertAfter(CompactList* cl, CLHandle handle, E data);
+/*
+ * Inserts data right before handle. Returns the new handle, or CL_NULL on
+ * failure.
+ */
+CLHandle CompactList_insertBefore(CompactList* cl, CLHandle handle, E data);
+/*
+ * Removes the node at handle from the list. Nonzero on failure.
+ */
+int CompactList_remove(CompactList* cl, CLHandle handle);
+/*
+ * Retrieves the handle of the head, or CL_NULL if the list is empty.
+ */
+CLHandle CompactList_getHead(const CompactList* cl);
+/*
+ * Retrieves the handle of the tail, or CL_NULL if the list is empty.
+ */
+CLHandle CompactList_getTail(const CompactList* cl);
+/*
+ * Retrieves the handle after handle, or CL_NULL if handle is the tail.
+ */
+CLHandle CompactList_getNext(const CompactList* cl, CLHandle handle);
+/*
+ * Retrieves the handle before handle, or CL_NULL if handle is the head.
+ */
+CLHandle CompactList_getPrev(const CompactList* cl, CLHandle handle);
+/*
+ * Retrieves the data at handle.
+ */
+E CompactList_getData(const CompactList* cl, CLHandle handle);
+/*
+ * Sets the data at handle. Nonzero on failure.
+ */
+int CompactList_setData(CompactList* cl, CLHandle handle, E data);
+/*
+ * Returns the number of elements in the list.
+ */
+size_t CompactList_getSize(const CompactList* cl);
+/*
+ * Returns the handle of the first node holding value, or CL_NULL if there
+ * is none.
+ */
+CLHandle CompactList_find(const CompactList* cl, E value);
+
+#endif
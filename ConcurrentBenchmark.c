@@ -0,0 +1,381 @@
+/*
+ * ConcurrentBenchmark - Measures how the throughput of the concurrent
+ * containers scales from 1 to N threads, next to their single-threaded
+ * counterparts wrapped in a global mutex.
+ * Every value pushed is tagged with its thread and iteration, and each
+ * thread keeps a count and a checksum of the tags it put in and took out.
+ * After a run, whatever is left in the container is drained into the same
+ * sums. Any lost or duplicated element makes the two sides differ, which
+ * is reported as an error, and the program then exits nonzero.
+ * Build: cc -std=c11 -O2 ConcurrentBenchmark.c ConcurrentDoubleStack.c
+ *        ConcurrentQueue.c ConcurrentDoublyLinkedList.c DoublyLinkedList.c
+ *        LockFreeArena.c DoubleStack.c -pthread
+ * Usage: ./a.out [max threads] [operations per thread]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "DoubleStack.h"
+#include "ConcurrentDoubleStack.h"
+#include "DoublyLinkedList.h"
+#include "ConcurrentQueue.h"
+#include "ConcurrentDoublyLinkedList.h"
+
+/*
+ * What every benchmark thread gets: the container to hammer and how many
+ * push/pop pairs to do. It hands back the counts and checksums of the tags
+ * it pushed and popped, and how many operations went wrong outright.
+ */
+typedef struct
+{
+	void* container;
+	long operations;
+	int id;
+	pthread_barrier_t* start;
+	long pushes;
+	long pops;
+	unsigned long long pushed;	// sum of Benchmark_mix of every tag pushed
+	unsigned long long popped;	// same for every tag popped
+	long errors;
+}BenchmarkJob;
+
+static pthread_mutex_t globalLock = PTHREAD_MUTEX_INITIALIZER;
+static int failures;	// runs that lost or duplicated elements
+
+/*
+ * Returns the time in seconds on a monotonic clock.
+ */
+static double Benchmark_now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+/*
+ * Returns the tag of iteration i of a job, unique over all the threads of
+ * a run. Anchors use the negative tags.
+ */
+static long long Benchmark_tag(BenchmarkJob* job, long i)
+{
+	return (long long)job->id * job->operations + i + 1;
+}
+/*
+ * Scrambles a tag (splitmix64), so that a lost element and a duplicated
+ * one can't cancel out in the checksums.
+ */
+static unsigned long long Benchmark_mix(long long tag)
+{
+	unsigned long long x = (unsigned long long)tag + 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+/*
+ * Counts tag as pushed by job.
+ */
+static void Benchmark_pushed(BenchmarkJob* job, long long tag)
+{
+	job->pushes++;
+	job->pushed += Benchmark_mix(tag);
+}
+/*
+ * Counts tag as popped by job.
+ */
+static void Benchmark_popped(BenchmarkJob* job, long long tag)
+{
+	job->pops++;
+	job->popped += Benchmark_mix(tag);
+}
+/*
+ * Pushes and pops a ConcurrentDoubleStack, two pushes to a pop and then the
+ * other way around so the stack neither runs dry nor keeps growing.
+ */
+static void* Benchmark_lockFreeStack(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	ConcurrentDoubleStack* cds = (ConcurrentDoubleStack*)job->container;
+	double value;
+	long i;
+	pthread_barrier_wait(job->start);
+	for(i = 0; i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		if(ConcurrentDoubleStack_push(cds, (double)tag)) job->errors++;
+		else Benchmark_pushed(job, tag);
+		if(!ConcurrentDoubleStack_pop(cds, &value)) Benchmark_popped(job, (long long)value);
+	}
+	return NULL;
+}
+/*
+ * Same as Benchmark_lockFreeStack, on a DoubleStack behind a global mutex.
+ */
+static void* Benchmark_lockedStack(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	DoubleStack* ds = (DoubleStack*)job->container;
+	long i;
+	pthread_barrier_wait(job->start);
+	for(i = 0; i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		pthread_mutex_lock(&globalLock);
+		if(DoubleStack_push(ds, (double)tag)) job->errors++;
+		else Benchmark_pushed(job, tag);
+		pthread_mutex_unlock(&globalLock);
+		pthread_mutex_lock(&globalLock);
+		double value = DoubleStack_pop(ds);
+		if(!ds->underflow) Benchmark_popped(job, (long long)value);
+		pthread_mutex_unlock(&globalLock);
+	}
+	return NULL;
+}
+/*
+ * Pushes onto the tail of a ConcurrentQueue and pops its head, like a
+ * thread that both produces and consumes work.
+ */
+static void* Benchmark_lockFreeQueue(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	ConcurrentQueue* cq = (ConcurrentQueue*)job->container;
+	E value;
+	long i;
+	pthread_barrier_wait(job->start);
+	for(i = 0; i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		if(ConcurrentQueue_pushTail(cq, (E)tag)) job->errors++;
+		else Benchmark_pushed(job, tag);
+		if(!ConcurrentQueue_popHead(cq, &value)) Benchmark_popped(job, (long long)value);
+	}
+	return NULL;
+}
+/*
+ * Same as Benchmark_lockFreeQueue, on a DoublyLinkedList behind a global
+ * mutex.
+ */
+static void* Benchmark_lockedQueue(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	DoublyLinkedList* dll = (DoublyLinkedList*)job->container;
+	long i;
+	pthread_barrier_wait(job->start);
+	for(i = 0; i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		pthread_mutex_lock(&globalLock);
+		if(DoublyLinkedList_pushTail(dll, (E)tag)) job->errors++;
+		else Benchmark_pushed(job, tag);
+		pthread_mutex_unlock(&globalLock);
+		pthread_mutex_lock(&globalLock);
+		if(dll->size > 0) Benchmark_popped(job, (long long)DoublyLinkedList_popHead(dll));
+		pthread_mutex_unlock(&globalLock);
+	}
+	return NULL;
+}
+/*
+ * Inserts next to a node of its own in a ConcurrentDoublyLinkedList and
+ * removes what it inserted, so every thread works on a different part of
+ * the list. The anchor stays in the list for the drain to find, and the new
+ * node has to be right after it, since no other thread inserts there.
+ */
+static void* Benchmark_fineGrainedList(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	ConcurrentDoublyLinkedList* cdll = (ConcurrentDoublyLinkedList*)job->container;
+	ConcurrentDLLNode* anchor = ConcurrentDoublyLinkedList_pushTail(cdll, (E)-(job->id + 1));
+	long i;
+	if(anchor == NULL) job->errors++;
+	else Benchmark_pushed(job, -(job->id + 1));
+	pthread_barrier_wait(job->start);
+	for(i = 0; anchor != NULL && i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		ConcurrentDLLNode* node = ConcurrentDoublyLinkedList_insertAfter(anchor, (E)tag);
+		if(node == NULL)
+		{
+			job->errors++;
+			continue;
+		}
+		Benchmark_pushed(job, tag);
+		if(atomic_load(&anchor->next) != node) job->errors++;
+		E value = ConcurrentDoublyLinkedList_getData(node);
+		if(ConcurrentDoublyLinkedList_remove(node)) job->errors++;
+		else Benchmark_popped(job, (long long)value);
+	}
+	return NULL;
+}
+/*
+ * Same as Benchmark_fineGrainedList, on a DoublyLinkedList behind a global
+ * mutex.
+ */
+static void* Benchmark_lockedList(void* arg)
+{
+	BenchmarkJob* job = (BenchmarkJob*)arg;
+	DoublyLinkedList* dll = (DoublyLinkedList*)job->container;
+	long i;
+	pthread_mutex_lock(&globalLock);
+	if(DoublyLinkedList_pushTail(dll, (E)-(job->id + 1))) job->errors++;
+	else Benchmark_pushed(job, -(job->id + 1));
+	DLLNode* anchor = dll->tail;
+	pthread_mutex_unlock(&globalLock);
+	pthread_barrier_wait(job->start);
+	for(i = 0; i < job->operations; i++)
+	{
+		long long tag = Benchmark_tag(job, i);
+		pthread_mutex_lock(&globalLock);
+		if(DoublyLinkedList_insertAfter(anchor, (E)tag)) job->errors++;
+		else Benchmark_pushed(job, tag);
+		pthread_mutex_unlock(&globalLock);
+		pthread_mutex_lock(&globalLock);
+		if(anchor->next != NULL)
+		{
+			Benchmark_popped(job, (long long)anchor->next->data);
+			DoublyLinkedList_remove(anchor->next);
+		}
+		pthread_mutex_unlock(&globalLock);
+	}
+	return NULL;
+}
+/*
+ * Drains what's left in a ConcurrentDoubleStack into job.
+ */
+static void Benchmark_drainLockFreeStack(void* container, BenchmarkJob* job)
+{
+	double value;
+	while(!ConcurrentDoubleStack_pop((ConcurrentDoubleStack*)container, &value))
+		Benchmark_popped(job, (long long)value);
+}
+/*
+ * Drains what's left in a DoubleStack into job.
+ */
+static void Benchmark_drainLockedStack(void* container, BenchmarkJob* job)
+{
+	DoubleStack* ds = (DoubleStack*)container;
+	while(ds->index > 0)
+		Benchmark_popped(job, (long long)DoubleStack_pop(ds));
+}
+/*
+ * Drains what's left in a ConcurrentQueue into job.
+ */
+static void Benchmark_drainLockFreeQueue(void* container, BenchmarkJob* job)
+{
+	E value;
+	while(!ConcurrentQueue_popHead((ConcurrentQueue*)container, &value))
+		Benchmark_popped(job, (long long)value);
+}
+/*
+ * Drains what's left in a DoublyLinkedList into job.
+ */
+static void Benchmark_drainLockedList(void* container, BenchmarkJob* job)
+{
+	DoublyLinkedList* dll = (DoublyLinkedList*)container;
+	while(dll->size > 0)
+		Benchmark_popped(job, (long long)DoublyLinkedList_popHead(dll));
+}
+/*
+ * Drains what's left in a ConcurrentDoublyLinkedList into job.
+ */
+static void Benchmark_drainFineGrainedList(void* container, BenchmarkJob* job)
+{
+	E value;
+	while(!ConcurrentDoublyLinkedList_popHead((ConcurrentDoublyLinkedList*)container, &value))
+		Benchmark_popped(job, (long long)value);
+}
+/*
+ * Runs body on threads threads against container and returns the total
+ * number of operations per second. Then drains the container with drain
+ * and checks that exactly what was pushed came out again, reporting the
+ * run as failed otherwise.
+ */
+static double Benchmark_run(const char* name, void* (*body)(void*),
+		void (*drain)(void*, BenchmarkJob*), void* container, int threads, long operations)
+{
+	pthread_t* ids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+	BenchmarkJob* jobs = (BenchmarkJob*)malloc(threads * sizeof(BenchmarkJob));
+	pthread_barrier_t start;
+	pthread_barrier_init(&start, NULL, threads + 1);
+	int i;
+	for(i = 0; i < threads; i++)
+	{
+		jobs[i].container = container;
+		jobs[i].operations = operations;
+		jobs[i].id = i;
+		jobs[i].start = &start;
+		jobs[i].pushes = jobs[i].pops = jobs[i].errors = 0;
+		jobs[i].pushed = jobs[i].popped = 0;
+		pthread_create(&ids[i], NULL, body, &jobs[i]);
+	}
+	double begin = Benchmark_now();
+	pthread_barrier_wait(&start);
+	for(i = 0; i < threads; i++)
+		pthread_join(ids[i], NULL);
+	double elapsed = Benchmark_now() - begin;
+	pthread_barrier_destroy(&start);
+	// jobs[0] sums up the whole run, leftovers included
+	for(i = 1; i < threads; i++)
+	{
+		jobs[0].pushes += jobs[i].pushes;
+		jobs[0].pops += jobs[i].pops;
+		jobs[0].pushed += jobs[i].pushed;
+		jobs[0].popped += jobs[i].popped;
+		jobs[0].errors += jobs[i].errors;
+	}
+	drain(container, &jobs[0]);
+	if(jobs[0].pushes != jobs[0].pops || jobs[0].pushed != jobs[0].popped || jobs[0].errors)
+	{
+		fprintf(stderr, "error: %s on %d threads pushed %ld and popped %ld elements, "
+				"%s, with %ld failed operations\n", name, threads, jobs[0].pushes, jobs[0].pops,
+				jobs[0].pushed == jobs[0].popped ? "same checksum" : "checksums differ",
+				jobs[0].errors);
+		failures++;
+	}
+	free(ids);
+	free(jobs);
+	// every iteration is a push and a pop
+	return 2.0 * operations * threads / elapsed;
+}
+
+int main(int argc, char** argv)
+{
+	int maxThreads = argc > 1 ? atoi(argv[1]) : 8;
+	long operations = argc > 2 ? atol(argv[2]) : 1000000;
+	int threads;
+	printf("%-24s %8s %14s\n", "container", "threads", "Mops/s");
+	for(threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		ConcurrentDoubleStack* cds = ConcurrentDoubleStack_create();
+		printf("%-24s %8d %14.2f\n", "ConcurrentDoubleStack", threads,
+				Benchmark_run("ConcurrentDoubleStack", Benchmark_lockFreeStack, Benchmark_drainLockFreeStack,
+						cds, threads, operations) / 1e6);
+		ConcurrentDoubleStack_free(cds);
+		DoubleStack* ds = DoubleStack_create(0);
+		printf("%-24s %8d %14.2f\n", "DoubleStack+mutex", threads,
+				Benchmark_run("DoubleStack+mutex", Benchmark_lockedStack, Benchmark_drainLockedStack,
+						ds, threads, operations) / 1e6);
+		DoubleStack_free(ds);
+		ConcurrentQueue* cq = ConcurrentQueue_create();
+		printf("%-24s %8d %14.2f\n", "ConcurrentQueue", threads,
+				Benchmark_run("ConcurrentQueue", Benchmark_lockFreeQueue, Benchmark_drainLockFreeQueue,
+						cq, threads, operations) / 1e6);
+		ConcurrentQueue_free(cq);
+		DoublyLinkedList* dll = DoublyLinkedList_create();
+		printf("%-24s %8d %14.2f\n", "DoublyLinkedList+mutex", threads,
+				Benchmark_run("DoublyLinkedList+mutex", Benchmark_lockedQueue, Benchmark_drainLockedList,
+						dll, threads, operations) / 1e6);
+		DoublyLinkedList_free(dll);
+		ConcurrentDoublyLinkedList* cdll = ConcurrentDoublyLinkedList_create();
+		printf("%-24s %8d %14.2f\n", "ConcurrentDLL (mid-list)", threads,
+				Benchmark_run("ConcurrentDLL (mid-list)", Benchmark_fineGrainedList, Benchmark_drainFineGrainedList,
+						cdll, threads, operations) / 1e6);
+		ConcurrentDoublyLinkedList_free(cdll);
+		dll = DoublyLinkedList_create();
+		printf("%-24s %8d %14.2f\n", "DLL+mutex (mid-list)", threads,
+				Benchmark_run("DLL+mutex (mid-list)", Benchmark_lockedList, Benchmark_drainLockedList,
+						dll, threads, operations) / 1e6);
+		DoublyLinkedList_free(dll);
+	}
+	return failures != 0;
+}
@@ -0,0 +1,89 @@
+/*
+ * ConcurrentDoubleStack - a lock-free stack of Doubles (a Treiber stack
+ * with tagged indexes against ABA) for several threads at once
+ */
+#include "ConcurrentDoubleStack.h"
+#include <stdlib.h>
+
+/*
+ * A CDSNode links to the node below it through next (an index, as far as
+ * the stack is concerned) and holds one value. The value is atomic only
+ * because a pop may read a node that's being recycled under it, in which
+ * case the pop's compare-and-swap fails and the value is thrown away.
+ */
+typedef struct
+{
+	_Atomic uint64_t next;
+	_Atomic double value;
+}CDSNode;
+
+/*
+ * Allocates an empty ConcurrentDoubleStack
+ */
+ConcurrentDoubleStack* ConcurrentDoubleStack_create()
+{
+	ConcurrentDoubleStack* cds = (ConcurrentDoubleStack*)aligned_alloc(
+			_Alignof(ConcurrentDoubleStack), sizeof(ConcurrentDoubleStack));
+	if(cds == NULL) return NULL;
+	LockFreeArena_init(&cds->nodes, sizeof(CDSNode));
+	atomic_init(&cds->top, LFA_TAGGED(0, LFA_NULL));
+	return cds;
+}
+/*
+ * Deallocates a ConcurrentDoubleStack
+ */
+void ConcurrentDoubleStack_free(ConcurrentDoubleStack* cds)
+{
+	if(cds == NULL) return;
+	LockFreeArena_destroy(&cds->nodes);
+	free(cds);
+}
+/*
+ * Pushes a value onto the ConcurrentDoubleStack
+ */
+int ConcurrentDoubleStack_push(ConcurrentDoubleStack* cds, double value)
+{
+	uint32_t index = LockFreeArena_alloc(&cds->nodes);
+	if(index == LFA_NULL) return 1;
+	CDSNode* node = (CDSNode*)LockFreeArena_get(&cds->nodes, index);
+	atomic_store_explicit(&node->value, value, memory_order_relaxed);
+	uint64_t top = atomic_load(&cds->top);
+	do
+	{
+		atomic_store_explicit(&node->next, top, memory_order_relaxed);
+	}while(!atomic_compare_exchange_weak(&cds->top, &top,
+			LFA_TAGGED(LFA_TAG(top) + 1, index)));
+	return 0;
+}
+/*
+ * Pops a value from the ConcurrentDoubleStack
+ */
+int ConcurrentDoubleStack_pop(ConcurrentDoubleStack* cds, double* value)
+{
+	uint64_t top = atomic_load(&cds->top);
+	for(;;)
+	{
+		if(LFA_INDEX(top) == LFA_NULL) return 1;
+		CDSNode* node = (CDSNode*)LockFreeArena_get(&cds->nodes, LFA_INDEX(top));
+		uint64_t next = atomic_load(&node->next);
+		double data = atomic_load_explicit(&node->value, memory_order_relaxed);
+		if(atomic_compare_exchange_weak(&cds->top, &top,
+				LFA_TAGGED(LFA_TAG(top) + 1, LFA_INDEX(next))))
+		{
+			LockFreeArena_release(&cds->nodes, LFA_INDEX(top));
+			if(value != NULL) *value = data;
+			return 0;
+		}
+	}
+}
+/*
+ * Reads the value on the top of the ConcurrentDoubleStack
+ */
+int ConcurrentDoubleStack_peek(ConcurrentDoubleStack* cds, double* value)
+{
+	uint64_t top = atomic_load(&cds->top);
+	if(LFA_INDEX(top) == LFA_NULL) return 1;
+	CDSNode* node = (CDSNode*)LockFreeArena_get(&cds->nodes, LFA_INDEX(top));
+	if(value != NULL) *value = atomic_load_explicit(&node->value, memory_order_relaxed);
+	return 0;
+}
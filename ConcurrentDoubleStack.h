@@ -0,0 +1,40 @@
+/**
+ * Interface for a ConcurrentDoubleStack
+ */
+#include "LockFreeArena.h"
+
+/*
+ * A ConcurrentDoubleStack is a stack of doubles that any number of threads
+ * can push to and pop from at once, without locks (a Treiber stack). Nodes
+ * come from a LockFreeArena and top is a tagged index, so a pop can't be
+ * fooled by a node that was popped and pushed again in the meantime.
+ * Link with -pthread (or whatever your platform needs for C11 atomics).
+ */
+typedef struct
+{
+	LockFreeArena nodes;
+	_Alignas(64) _Atomic uint64_t top;	// on a cache line of its own
+	char padding[64 - sizeof(uint64_t)];
+}ConcurrentDoubleStack;
+
+/*
+ * Allocates an empty ConcurrentDoubleStack. Returns NULL on failure.
+ */
+ConcurrentDoubleStack* ConcurrentDoubleStack_create();
+/*
+ * Deallocates a ConcurrentDoubleStack. No other thread may be using it.
+ */
+void ConcurrentDoubleStack_free(ConcurrentDoubleStack* cds);
+/*
+ * Pushes a value onto the stack. Nonzero on failure.
+ */
+int ConcurrentDoubleStack_push(ConcurrentDoubleStack* cds, double value);
+/*
+ * Pops a value off of the stack into value. Nonzero if the stack is empty.
+ */
+int ConcurrentDoubleStack_pop(ConcurrentDoubleStack* cds, double* value);
+/*
+ * Reads the value on top of the stack into value, which another thread may
+ * pop at any moment. Nonzero if the stack is empty.
+ */
+int ConcurrentDoubleStack_peek(ConcurrentDoubleStack* cds, double* value);
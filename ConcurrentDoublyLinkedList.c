@@ -0,0 +1,284 @@
+/*
+ * ConcurrentDoublyLinkedList - A doubly-linked list of values of type E with
+ * a lock per node, for inserting and removing anywhere from several threads
+ * at once. E is generic and can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <assert.h>
+#include <sched.h>
+#include "ConcurrentDoublyLinkedList.h"
+
+/*
+ * Takes the lock of node, yielding every now and then so a thread that got
+ * preempted while holding it gets to finish.
+ */
+static void ConcurrentDoublyLinkedList_lock(ConcurrentDLLNode* node)
+{
+	unsigned int spins = 0;
+	while(atomic_flag_test_and_set_explicit(&node->lock, memory_order_acquire))
+	{
+		if(++spins % 64 == 0) sched_yield();
+	}
+}
+/*
+ * Gives back the lock of node
+ */
+static void ConcurrentDoublyLinkedList_unlock(ConcurrentDLLNode* node)
+{
+	atomic_flag_clear_explicit(&node->lock, memory_order_release);
+}
+/*
+ * Sets up node as an unlinked, unlocked node of cdll
+ */
+static void ConcurrentDoublyLinkedList_initNode(ConcurrentDoublyLinkedList* cdll,
+		ConcurrentDLLNode* node, E data)
+{
+	atomic_init(&node->next, NULL);
+	atomic_init(&node->prev, NULL);
+	node->retired = NULL;
+	node->list = cdll;
+	atomic_flag_clear(&node->lock);
+	atomic_init(&node->removed, 0);
+	node->data = data;
+}
+/*
+ * Allocates a node holding data and links it between pred and succ, whose
+ * locks the caller holds. Returns NULL on failure.
+ */
+static ConcurrentDLLNode* ConcurrentDoublyLinkedList_link(ConcurrentDLLNode* pred,
+		ConcurrentDLLNode* succ, E data)
+{
+	ConcurrentDoublyLinkedList* cdll = pred->list;
+	ConcurrentDLLNode* node = (ConcurrentDLLNode*)malloc(sizeof(ConcurrentDLLNode));
+	if(node == NULL) return NULL;
+	ConcurrentDoublyLinkedList_initNode(cdll, node, data);
+	atomic_store_explicit(&node->prev, pred, memory_order_relaxed);
+	atomic_store_explicit(&node->next, succ, memory_order_relaxed);
+	// publishing the node through pred->next releases data to lock-free readers
+	atomic_store(&pred->next, node);
+	atomic_store(&succ->prev, node);
+	atomic_fetch_add(&cdll->size, 1);
+	return node;
+}
+/*
+ * Puts an unlinked node on the retire list, to be freed on the next reclaim
+ */
+static void ConcurrentDoublyLinkedList_retire(ConcurrentDLLNode* node)
+{
+	ConcurrentDoublyLinkedList* cdll = node->list;
+	ConcurrentDLLNode* top = atomic_load(&cdll->retired);
+	do
+	{
+		node->retired = top;
+	}while(!atomic_compare_exchange_weak(&cdll->retired, &top, node));
+}
+/*
+ * Locks the node before node and node itself, in that order, once the one
+ * before is still linked to node. Returns the node before, or NULL if node
+ * was removed, in which case nothing is locked.
+ */
+static ConcurrentDLLNode* ConcurrentDoublyLinkedList_lockWithPrev(ConcurrentDLLNode* node)
+{
+	for(;;)
+	{
+		ConcurrentDLLNode* pred = atomic_load(&node->prev);
+		ConcurrentDoublyLinkedList_lock(pred);
+		// holding pred, its link to node can only change under us if it's stale
+		if(!atomic_load(&pred->removed) && atomic_load(&pred->next) == node)
+		{
+			ConcurrentDoublyLinkedList_lock(node);
+			return pred;
+		}
+		ConcurrentDoublyLinkedList_unlock(pred);
+		if(atomic_load(&node->removed)) return NULL;
+	}
+}
+/*
+ * Unlinks node, whose predecessor pred and itself are locked by the caller,
+ * and retires it. Unlocks all three nodes involved.
+ */
+static void ConcurrentDoublyLinkedList_unlink(ConcurrentDLLNode* pred, ConcurrentDLLNode* node)
+{
+	ConcurrentDLLNode* succ = atomic_load(&node->next);
+	ConcurrentDoublyLinkedList_lock(succ);
+	atomic_store(&pred->next, succ);
+	atomic_store(&succ->prev, pred);
+	atomic_store(&node->removed, 1);
+	ConcurrentDoublyLinkedList_unlock(succ);
+	ConcurrentDoublyLinkedList_unlock(node);
+	ConcurrentDoublyLinkedList_unlock(pred);
+	atomic_fetch_sub(&node->list->size, 1);
+	ConcurrentDoublyLinkedList_retire(node);
+}
+/*
+ * Allocates an empty ConcurrentDoublyLinkedList
+ */
+ConcurrentDoublyLinkedList* ConcurrentDoublyLinkedList_create()
+{
+	ConcurrentDoublyLinkedList* cdll = (ConcurrentDoublyLinkedList*)malloc(
+			sizeof(ConcurrentDoublyLinkedList));
+	if(cdll == NULL) return NULL;
+	ConcurrentDoublyLinkedList_initNode(cdll, &cdll->head, (E)0);
+	ConcurrentDoublyLinkedList_initNode(cdll, &cdll->tail, (E)0);
+	atomic_init(&cdll->head.next, &cdll->tail);
+	atomic_init(&cdll->tail.prev, &cdll->head);
+	atomic_init(&cdll->size, 0);
+	atomic_init(&cdll->retired, NULL);
+	return cdll;
+}
+/*
+ * Deallocates a ConcurrentDoublyLinkedList along with its removed nodes
+ */
+void ConcurrentDoublyLinkedList_free(ConcurrentDoublyLinkedList* cdll)
+{
+	if(cdll == NULL) return;
+	ConcurrentDLLNode* node = atomic_load(&cdll->head.next);
+	while(node != &cdll->tail)
+	{
+		ConcurrentDLLNode* next = atomic_load(&node->next);
+		free(node);
+		node = next;
+	}
+	ConcurrentDoublyLinkedList_reclaim(cdll);
+	free(cdll);
+}
+/*
+ * Deallocates the nodes removed from the list so far
+ */
+void ConcurrentDoublyLinkedList_reclaim(ConcurrentDoublyLinkedList* cdll)
+{
+	ConcurrentDLLNode* node = atomic_exchange(&cdll->retired, NULL);
+	while(node != NULL)
+	{
+		ConcurrentDLLNode* next = node->retired;
+		free(node);
+		node = next;
+	}
+}
+/*
+ * Adds an entry to the tail end of the list
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_pushTail(ConcurrentDoublyLinkedList* cdll, E data)
+{
+	return ConcurrentDoublyLinkedList_insertBefore(&cdll->tail, data);
+}
+/*
+ * Adds an entry to the head of the list
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_pushHead(ConcurrentDoublyLinkedList* cdll, E data)
+{
+	return ConcurrentDoublyLinkedList_insertAfter(&cdll->head, data);
+}
+/*
+ * Pops the tail off of the list into data. Nonzero if the list is empty.
+ */
+int ConcurrentDoublyLinkedList_popTail(ConcurrentDoublyLinkedList* cdll, E* data)
+{
+	for(;;)
+	{
+		ConcurrentDLLNode* last = atomic_load(&cdll->tail.prev);
+		if(last == &cdll->head) return 1;
+		ConcurrentDLLNode* pred = ConcurrentDoublyLinkedList_lockWithPrev(last);
+		if(pred == NULL) continue;
+		// somebody may have pushed onto the tail in the meantime
+		if(atomic_load(&last->next) != &cdll->tail)
+		{
+			ConcurrentDoublyLinkedList_unlock(last);
+			ConcurrentDoublyLinkedList_unlock(pred);
+			continue;
+		}
+		if(data != NULL) *data = last->data;
+		ConcurrentDoublyLinkedList_unlink(pred, last);
+		return 0;
+	}
+}
+/*
+ * Pops the head off of the list into data. Nonzero if the list is empty.
+ */
+int ConcurrentDoublyLinkedList_popHead(ConcurrentDoublyLinkedList* cdll, E* data)
+{
+	ConcurrentDoublyLinkedList_lock(&cdll->head);
+	ConcurrentDLLNode* first = atomic_load(&cdll->head.next);
+	if(first == &cdll->tail)
+	{
+		ConcurrentDoublyLinkedList_unlock(&cdll->head);
+		return 1;
+	}
+	ConcurrentDoublyLinkedList_lock(first);
+	if(data != NULL) *data = first->data;
+	ConcurrentDoublyLinkedList_unlink(&cdll->head, first);
+	return 0;
+}
+/*
+ * Inserts an element after the specified node
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_insertAfter(ConcurrentDLLNode* node, E data)
+{
+	assert(node != &node->list->tail);
+	ConcurrentDoublyLinkedList_lock(node);
+	if(atomic_load(&node->removed))
+	{
+		ConcurrentDoublyLinkedList_unlock(node);
+		return NULL;
+	}
+	// node->next can't change while node is locked
+	ConcurrentDLLNode* succ = atomic_load(&node->next);
+	ConcurrentDoublyLinkedList_lock(succ);
+	ConcurrentDLLNode* inserted = ConcurrentDoublyLinkedList_link(node, succ, data);
+	ConcurrentDoublyLinkedList_unlock(succ);
+	ConcurrentDoublyLinkedList_unlock(node);
+	return inserted;
+}
+/*
+ * Inserts an element before the specified node
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_insertBefore(ConcurrentDLLNode* node, E data)
+{
+	assert(node != &node->list->head);
+	ConcurrentDLLNode* pred = ConcurrentDoublyLinkedList_lockWithPrev(node);
+	if(pred == NULL) return NULL;
+	ConcurrentDLLNode* inserted = ConcurrentDoublyLinkedList_link(pred, node, data);
+	ConcurrentDoublyLinkedList_unlock(node);
+	ConcurrentDoublyLinkedList_unlock(pred);
+	return inserted;
+}
+/*
+ * Removes the specified node from the list
+ */
+int ConcurrentDoublyLinkedList_remove(ConcurrentDLLNode* node)
+{
+	assert(node != &node->list->head && node != &node->list->tail);
+	ConcurrentDLLNode* pred = ConcurrentDoublyLinkedList_lockWithPrev(node);
+	if(pred == NULL) return 1;
+	ConcurrentDoublyLinkedList_unlink(pred, node);
+	return 0;
+}
+/*
+ * Returns the first node holding value, walking the list without locks
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_find(ConcurrentDoublyLinkedList* cdll, E value)
+{
+	ConcurrentDLLNode* node;
+	CONCURRENTDLL_TRAVERSAL(cdll, node)
+	{
+		if(node->data == value && !atomic_load(&node->removed))
+			return node;
+	}
+	return NULL;
+}
+/*
+ * Returns the data of node
+ */
+E ConcurrentDoublyLinkedList_getData(ConcurrentDLLNode* node)
+{
+	return node->data;
+}
+/*
+ * Returns the size of the list
+ */
+size_t ConcurrentDoublyLinkedList_getSize(ConcurrentDoublyLinkedList* cdll)
+{
+	return atomic_load(&cdll->size);
+}
@@ -0,0 +1,140 @@
+/*
+ * ConcurrentDoublyLinkedList - A doubly-linked list that many threads can
+ * insert into and remove from anywhere at once
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef CONCURRENTDOUBLYLINKEDLIST_H
+#define CONCURRENTDOUBLYLINKEDLIST_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing ConcurrentDoublyLinkedList.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+/*
+ * Traverses the list from head to tail without taking any locks, skipping
+ * the sentinels. Nodes other threads remove along the way may or may not be
+ * visited, but the walk always ends.
+ * Usage:
+ * ConcurrentDLLNode* handle;
+ * CONCURRENTDLL_TRAVERSAL(list, handle)
+ * {
+ *      [handle points to the current node]
+ * }
+ */
+#define CONCURRENTDLL_TRAVERSAL(CDLL, NODE)								\
+	for(NODE = atomic_load(&(CDLL)->head.next); NODE != &(CDLL)->tail;	\
+			NODE = atomic_load(&NODE->next))
+
+/*
+ * A ConcurrentDLLNode is like a DLLNode with a spinlock of its own. A node
+ * is only ever linked or unlinked while holding the locks of it and its
+ * neighbours, always taken from head to tail, so threads working on
+ * different parts of the list never wait on each other.
+ * data is set once, when the node is linked, and never changes after that.
+ */
+typedef struct ConcurrentDLLNode
+{
+	_Atomic(struct ConcurrentDLLNode*) next;
+	_Atomic(struct ConcurrentDLLNode*) prev;
+	struct ConcurrentDLLNode* retired;		// next node on the retire list
+	struct ConcurrentDoublyLinkedList* list;
+	atomic_flag lock;
+	_Atomic int removed;					// set once unlinked, never cleared
+	E data;
+}ConcurrentDLLNode;
+
+/*
+ * A ConcurrentDoublyLinkedList keeps a sentinel node at each end, so every
+ * real node always has a neighbour to lock on either side.
+ * Removed nodes aren't freed right away, since another thread may still be
+ * holding or walking through them; they go on a retire list that's freed by
+ * ConcurrentDoublyLinkedList_reclaim or ConcurrentDoublyLinkedList_free,
+ * once nobody can be looking at them anymore.
+ * Link with -pthread (or whatever your platform needs for C11 atomics).
+ */
+typedef struct ConcurrentDoublyLinkedList
+{
+	ConcurrentDLLNode head;
+	ConcurrentDLLNode tail;
+	_Atomic size_t size;
+	_Atomic(ConcurrentDLLNode*) retired;
+}ConcurrentDoublyLinkedList;
+
+/*
+ * Allocates an empty ConcurrentDoublyLinkedList. Returns NULL on failure.
+ */
+ConcurrentDoublyLinkedList* ConcurrentDoublyLinkedList_create();
+/*
+ * Deallocates a ConcurrentDoublyLinkedList and every node it has or had.
+ * No other thread may be using it.
+ */
+void ConcurrentDoublyLinkedList_free(ConcurrentDoublyLinkedList* cdll);
+/*
+ * Deallocates the nodes removed from the list so far. No other thread may be
+ * using the list or holding any of its nodes while this runs.
+ */
+void ConcurrentDoublyLinkedList_reclaim(ConcurrentDoublyLinkedList* cdll);
+/*
+ * Adds an entry to the tail end of the list. Returns its node, or NULL on
+ * failure.
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_pushTail(ConcurrentDoublyLinkedList* cdll, E data);
+/*
+ * Adds an entry to the head of the list. Returns its node, or NULL on
+ * failure.
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_pushHead(ConcurrentDoublyLinkedList* cdll, E data);
+/*
+ * Pops the tail off of the list into data. Nonzero if the list is empty.
+ */
+int ConcurrentDoublyLinkedList_popTail(ConcurrentDoublyLinkedList* cdll, E* data);
+/*
+ * Pops the head off of the list into data. Nonzero if the list is empty.
+ */
+int ConcurrentDoublyLinkedList_popHead(ConcurrentDoublyLinkedList* cdll, E* data);
+/*
+ * Inserts an element after the specified node. Returns the new node, or
+ * NULL on failure or if node has been removed.
+ * Unlike DoublyLinkedList_insertAfter, this hands back the new node, since
+ * by the time it returns another thread may have put something else next
+ * to node.
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_insertAfter(ConcurrentDLLNode* node, E data);
+/*
+ * Inserts an element before the specified node. Returns the new node, or
+ * NULL on failure or if node has been removed.
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_insertBefore(ConcurrentDLLNode* node, E data);
+/*
+ * Removes the specified node from the list. Nonzero if it was already
+ * removed. The node stays readable until the list is reclaimed.
+ */
+int ConcurrentDoublyLinkedList_remove(ConcurrentDLLNode* node);
+/*
+ * Returns the first node holding value that was in the list when it was
+ * passed, or NULL if there's none. Takes no locks.
+ */
+ConcurrentDLLNode* ConcurrentDoublyLinkedList_find(ConcurrentDoublyLinkedList* cdll, E value);
+/*
+ * Returns the data of node
+ */
+E ConcurrentDoublyLinkedList_getData(ConcurrentDLLNode* node);
+/*
+ * Returns the size of the list when it was looked at
+ */
+size_t ConcurrentDoublyLinkedList_getSize(ConcurrentDoublyLinkedList* cdll);
+
+#endif
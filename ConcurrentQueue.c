@@ -0,0 +1,153 @@
+/*
+ * ConcurrentQueue - A lock-free Michael-Scott queue of values of type E,
+ * which are generic and can be specified explicitly by calling
+ * #define GENERICS [type]
+ * Nodes are linked by tagged indexes into a LockFreeArena, so recycling a
+ * node can never confuse a thread that's still looking at it.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "ConcurrentQueue.h"
+
+#define CQ_WORDS ((sizeof(E) + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+
+/*
+ * A CQNode links to the node behind it through next and holds one value,
+ * kept in atomic words because a consumer reads it before it knows whether
+ * the node is still in the queue.
+ */
+typedef struct
+{
+	_Atomic uint64_t next;
+	_Atomic uint64_t data[CQ_WORDS];
+}CQNode;
+
+/*
+ * Returns the node at index.
+ */
+static CQNode* ConcurrentQueue_node(ConcurrentQueue* cq, uint32_t index)
+{
+	return (CQNode*)LockFreeArena_get(&cq->nodes, index);
+}
+/*
+ * Allocates a node with no next node, holding data. Returns LFA_NULL on
+ * failure.
+ */
+static uint32_t ConcurrentQueue_newNode(ConcurrentQueue* cq, E data)
+{
+	uint32_t index = LockFreeArena_alloc(&cq->nodes);
+	if(index == LFA_NULL) return LFA_NULL;
+	CQNode* node = ConcurrentQueue_node(cq, index);
+	uint64_t words[CQ_WORDS] = { 0 };
+	memcpy(words, &data, sizeof(E));
+	size_t i;
+	for(i = 0; i < CQ_WORDS; i++)
+		atomic_store_explicit(&node->data[i], words[i], memory_order_relaxed);
+	uint64_t next = atomic_load_explicit(&node->next, memory_order_relaxed);
+	atomic_store(&node->next, LFA_TAGGED(LFA_TAG(next) + 1, LFA_NULL));
+	return index;
+}
+/*
+ * Allocates an empty ConcurrentQueue
+ */
+ConcurrentQueue* ConcurrentQueue_create()
+{
+	ConcurrentQueue* cq = (ConcurrentQueue*)aligned_alloc(
+			_Alignof(ConcurrentQueue), sizeof(ConcurrentQueue));
+	if(cq == NULL) return NULL;
+	LockFreeArena_init(&cq->nodes, sizeof(CQNode));
+	uint32_t dummy = ConcurrentQueue_newNode(cq, (E)0);
+	if(dummy == LFA_NULL)
+	{
+		LockFreeArena_destroy(&cq->nodes);
+		free(cq);
+		return NULL;
+	}
+	atomic_init(&cq->head, LFA_TAGGED(0, dummy));
+	atomic_init(&cq->tail, LFA_TAGGED(0, dummy));
+	return cq;
+}
+/*
+ * Deallocates a ConcurrentQueue
+ */
+void ConcurrentQueue_free(ConcurrentQueue* cq)
+{
+	if(cq == NULL) return;
+	LockFreeArena_destroy(&cq->nodes);
+	free(cq);
+}
+/*
+ * Adds an entry to the tail end of the queue. Nonzero on failure.
+ */
+int ConcurrentQueue_pushTail(ConcurrentQueue* cq, E data)
+{
+	uint32_t index = ConcurrentQueue_newNode(cq, data);
+	if(index == LFA_NULL) return 1;
+	uint64_t tail;
+	for(;;)
+	{
+		tail = atomic_load(&cq->tail);
+		CQNode* last = ConcurrentQueue_node(cq, LFA_INDEX(tail));
+		uint64_t next = atomic_load(&last->next);
+		if(tail != atomic_load(&cq->tail)) continue;
+		if(LFA_INDEX(next) == LFA_NULL)
+		{
+			if(atomic_compare_exchange_weak(&last->next, &next,
+					LFA_TAGGED(LFA_TAG(next) + 1, index)))
+				break;
+		}
+		else
+		{
+			// tail fell behind, help it along
+			atomic_compare_exchange_weak(&cq->tail, &tail,
+					LFA_TAGGED(LFA_TAG(tail) + 1, LFA_INDEX(next)));
+		}
+	}
+	atomic_compare_exchange_strong(&cq->tail, &tail,
+			LFA_TAGGED(LFA_TAG(tail) + 1, index));
+	return 0;
+}
+/*
+ * Pops the head off the queue into data. Nonzero if the queue is empty.
+ */
+int ConcurrentQueue_popHead(ConcurrentQueue* cq, E* data)
+{
+	uint64_t words[CQ_WORDS];
+	uint64_t head;
+	for(;;)
+	{
+		head = atomic_load(&cq->head);
+		uint64_t tail = atomic_load(&cq->tail);
+		CQNode* dummy = ConcurrentQueue_node(cq, LFA_INDEX(head));
+		uint64_t next = atomic_load(&dummy->next);
+		if(head != atomic_load(&cq->head)) continue;
+		if(LFA_INDEX(head) == LFA_INDEX(tail))
+		{
+			if(LFA_INDEX(next) == LFA_NULL) return 1;
+			atomic_compare_exchange_weak(&cq->tail, &tail,
+					LFA_TAGGED(LFA_TAG(tail) + 1, LFA_INDEX(next)));
+			continue;
+		}
+		// read the value before moving head, after which it may be recycled
+		CQNode* first = ConcurrentQueue_node(cq, LFA_INDEX(next));
+		size_t i;
+		for(i = 0; i < CQ_WORDS; i++)
+			words[i] = atomic_load_explicit(&first->data[i], memory_order_relaxed);
+		if(atomic_compare_exchange_weak(&cq->head, &head,
+				LFA_TAGGED(LFA_TAG(head) + 1, LFA_INDEX(next))))
+			break;
+	}
+	// the old dummy is out of the queue, and first is the new one
+	LockFreeArena_release(&cq->nodes, LFA_INDEX(head));
+	if(data != NULL) memcpy(data, words, sizeof(E));
+	return 0;
+}
+/*
+ * Returns 1 if the queue was empty when looked at, and 0 if not.
+ */
+int ConcurrentQueue_isEmpty(ConcurrentQueue* cq)
+{
+	uint64_t head = atomic_load(&cq->head);
+	CQNode* dummy = ConcurrentQueue_node(cq, LFA_INDEX(head));
+	return LFA_INDEX(atomic_load(&dummy->next)) == LFA_NULL;
+}
@@ -0,0 +1,61 @@
+/*
+ * ConcurrentQueue - A lock-free FIFO queue for many producers and consumers
+ *
+ *  Created on: Oct 17, 2026
+ */
+#include "LockFreeArena.h"
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing ConcurrentQueue.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+/*
+ * A ConcurrentQueue is a Michael-Scott queue: a singly-linked list with a
+ * dummy node at the head, where producers compare-and-swap onto the tail
+ * and consumers compare-and-swap the head forward, so neither ever waits on
+ * the other or on a lock. It has the pushTail/popHead entry points that a
+ * DoublyLinkedList used as a work queue would.
+ * Nodes come from a LockFreeArena, which keeps them readable even after
+ * they're recycled, and every link is a tagged index, which is how popped
+ * nodes are reclaimed safely while other threads may still be looking at
+ * them. head and tail sit on cache lines of their own.
+ * Link with -pthread (or whatever your platform needs for C11 atomics).
+ */
+typedef struct
+{
+	LockFreeArena nodes;
+	_Alignas(64) _Atomic uint64_t head;
+	char headPadding[64 - sizeof(uint64_t)];
+	_Atomic uint64_t tail;
+	char tailPadding[64 - sizeof(uint64_t)];
+}ConcurrentQueue;
+
+/*
+ * Allocates an empty ConcurrentQueue. Returns NULL on failure.
+ */
+ConcurrentQueue* ConcurrentQueue_create();
+/*
+ * Deallocates a ConcurrentQueue. No other thread may be using it.
+ */
+void ConcurrentQueue_free(ConcurrentQueue* cq);
+/*
+ * Adds an entry to the tail end of the queue. Nonzero on failure.
+ */
+int ConcurrentQueue_pushTail(ConcurrentQueue* cq, E data);
+/*
+ * Pops the head off the queue into data. Nonzero if the queue is empty.
+ */
+int ConcurrentQueue_popHead(ConcurrentQueue* cq, E* data);
+/*
+ * Returns 1 if the queue was empty when looked at, and 0 if not.
+ */
+int ConcurrentQueue_isEmpty(ConcurrentQueue* cq);
@@ -0,0 +1,59 @@
+/*
+ * ContainerStats - Optional counters kept by the containers
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef CONTAINERSTATS_H
+#define CONTAINERSTATS_H
+
+#include <stddef.h>
+
+/*
+ * ContainerStats are what a DoublyLinkedList, CircularDoublyLinkedList or
+ * DoubleStack counts about itself when every file using them is compiled
+ * with -DCONTAINER_STATS, to tell whether a slow container is busy
+ * allocating, comparing or walking:
+ * allocations and frees are calls to malloc/realloc and free (for a list
+ * with a DLLNodePool, nodes taken from and given back to the pool),
+ * compares are calls to the container's compare function, nodesVisited are
+ * the nodes (or index entries) find and sortedInsert look at, overflows are
+ * failed allocations, underflows are pops and removes on an empty container,
+ * and peakSize is the most elements it ever held.
+ * Without CONTAINER_STATS, the containers have no stats member and the
+ * counting macros below expand to nothing, so they cost nothing.
+ * (note: CONTAINER_STATS changes the layout of the containers, so it has to
+ * be defined, or not, for the whole program)
+ */
+typedef struct
+{
+	unsigned long long allocations;
+	unsigned long long frees;
+	unsigned long long compares;
+	unsigned long long nodesVisited;
+	unsigned long long overflows;
+	unsigned long long underflows;
+	size_t peakSize;
+}ContainerStats;
+
+#ifdef CONTAINER_STATS
+#define CONTAINER_STATS_MEMBER ContainerStats stats;
+#define CONTAINER_STATS_ADD(C, FIELD, N) ((C)->stats.FIELD += (N))
+#define CONTAINER_STATS_PEAK(C, SIZE)									\
+	((C)->stats.peakSize < (size_t)(SIZE) ? (void)((C)->stats.peakSize = (SIZE)) : (void)0)
+#define CONTAINER_STATS_RESET(C) ((C)->stats = (ContainerStats){ 0 })
+/*
+ * Copies the stats of C into OUT and evaluates to 0.
+ */
+#define CONTAINER_STATS_GET(C, OUT) (*(OUT) = (C)->stats, 0)
+#else
+#define CONTAINER_STATS_MEMBER
+#define CONTAINER_STATS_ADD(C, FIELD, N) ((void)(C))
+#define CONTAINER_STATS_PEAK(C, SIZE) ((void)(C))
+#define CONTAINER_STATS_RESET(C) ((void)(C))
+/*
+ * Zeroes OUT and evaluates to 1, as there are no stats to copy.
+ */
+#define CONTAINER_STATS_GET(C, OUT) ((void)(C), *(OUT) = (ContainerStats){ 0 }, 1)
+#endif
+
+#endif
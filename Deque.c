@@ -0,0 +1,195 @@
+/*
+ * Deque - A double-ended queue of values of type E, which are generic and
+ * can be specified explicitly by calling
+ * #define GENERICS [type]
+ * Elements are kept in fixed-size blocks reached through a block map, see
+ * Deque.h.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "Deque.h"
+
+/*
+ * Makes sure the block slot index holds a block, taking the spare if there
+ * is one. Nonzero on failure.
+ */
+static int Deque_fillBlock(Deque* dq, size_t index)
+{
+	if(dq->map[index] != NULL) return 0;
+	if(dq->spare != NULL)
+	{
+		dq->map[index] = dq->spare;
+		dq->spare = NULL;
+		return 0;
+	}
+	dq->map[index] = (E*)malloc(DEQUE_BLOCK_SIZE * sizeof(E));
+	return dq->map[index] == NULL;
+}
+/*
+ * Takes the now empty block out of slot index, keeping it as the spare if
+ * there isn't one yet.
+ */
+static void Deque_emptyBlock(Deque* dq, size_t index)
+{
+	if(dq->spare == NULL) dq->spare = dq->map[index];
+	else free(dq->map[index]);
+	dq->map[index] = NULL;
+}
+/*
+ * Moves the blocks in use back to the middle of the map, doubling the map
+ * first if they'd take up more than half of it, to make room for one more
+ * block at the head (atHead) or at the tail. Nonzero on failure.
+ */
+static int Deque_makeRoom(Deque* dq, int atHead)
+{
+	size_t first = dq->head / DEQUE_BLOCK_SIZE;
+	size_t used = dq->size ? (dq->head + dq->size - 1) / DEQUE_BLOCK_SIZE - first + 1 : 0;
+	size_t mapSize = dq->mapSize;
+	while((used + 1) * 2 > mapSize)
+		mapSize *= 2;
+	// leave the new block's slot free on the side that needs it
+	size_t target = (mapSize - used) / 2 + (atHead ? 1 : 0);
+	if(mapSize != dq->mapSize)
+	{
+		E** map = (E**)calloc(mapSize, sizeof(E*));
+		if(map == NULL) return 1;
+		memcpy(map + target, dq->map + first, used * sizeof(E*));
+		free(dq->map);
+		dq->map = map;
+		dq->mapSize = mapSize;
+	}
+	else
+	{
+		memmove(dq->map + target, dq->map + first, used * sizeof(E*));
+		// clear the slots the blocks moved out of
+		if(target > first)
+			memset(dq->map + first, 0, (target - first < used ? target - first : used) * sizeof(E*));
+		else
+		{
+			size_t from = first > target + used ? first : target + used;
+			memset(dq->map + from, 0, (first + used - from) * sizeof(E*));
+		}
+	}
+	dq->head = target * DEQUE_BLOCK_SIZE + dq->head % DEQUE_BLOCK_SIZE;
+	return 0;
+}
+/*
+ * Puts the head of an empty deque in the middle of its map.
+ */
+static void Deque_center(Deque* dq)
+{
+	dq->head = dq->mapSize / 2 * DEQUE_BLOCK_SIZE;
+}
+/*
+ * Allocates an empty Deque
+ */
+Deque* Deque_create()
+{
+	Deque* dq = (Deque*)malloc(sizeof(Deque));
+	if(dq == NULL) return NULL;
+	dq->map = (E**)calloc(DEQUE_MAP_SIZE, sizeof(E*));
+	if(dq->map == NULL)
+	{
+		free(dq);
+		return NULL;
+	}
+	dq->mapSize = DEQUE_MAP_SIZE;
+	dq->size = 0;
+	dq->spare = NULL;
+	Deque_center(dq);
+	return dq;
+}
+/*
+ * Deallocates a Deque
+ */
+void Deque_free(Deque* dq)
+{
+	if(dq == NULL) return;
+	size_t i;
+	for(i = 0; i < dq->mapSize; i++)
+		free(dq->map[i]);
+	free(dq->spare);
+	free(dq->map);
+	free(dq);
+}
+/*
+ * Adds an entry to the tail end of the deque. Nonzero on failure.
+ */
+int Deque_pushTail(Deque* dq, E data)
+{
+	assert(dq != NULL);
+	size_t position = dq->head + dq->size;
+	if(position == dq->mapSize * DEQUE_BLOCK_SIZE)
+	{
+		if(Deque_makeRoom(dq, 0)) return 1;
+		position = dq->head + dq->size;
+	}
+	if(Deque_fillBlock(dq, position / DEQUE_BLOCK_SIZE)) return 1;
+	dq->map[position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE] = data;
+	dq->size++;
+	return 0;
+}
+/*
+ * Adds an entry to the head end of the deque. Nonzero on failure.
+ */
+int Deque_pushHead(Deque* dq, E data)
+{
+	assert(dq != NULL);
+	if(dq->head == 0 && Deque_makeRoom(dq, 1)) return 1;
+	size_t position = dq->head - 1;
+	if(Deque_fillBlock(dq, position / DEQUE_BLOCK_SIZE)) return 1;
+	dq->map[position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE] = data;
+	dq->head = position;
+	dq->size++;
+	return 0;
+}
+/*
+ * Pops and returns the tail off the deque
+ */
+E Deque_popTail(Deque* dq)
+{
+	assert(dq != NULL);
+	assert(dq->size > 0);
+	size_t position = dq->head + dq->size - 1;
+	E data = dq->map[position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+	dq->size--;
+	if(position % DEQUE_BLOCK_SIZE == 0 || dq->size == 0)
+		Deque_emptyBlock(dq, position / DEQUE_BLOCK_SIZE);
+	if(dq->size == 0) Deque_center(dq);
+	return data;
+}
+/*
+ * Pops and returns the head off the deque
+ */
+E Deque_popHead(Deque* dq)
+{
+	assert(dq != NULL);
+	assert(dq->size > 0);
+	size_t position = dq->head;
+	E data = dq->map[position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+	dq->head++;
+	dq->size--;
+	if(dq->head % DEQUE_BLOCK_SIZE == 0 || dq->size == 0)
+		Deque_emptyBlock(dq, position / DEQUE_BLOCK_SIZE);
+	if(dq->size == 0) Deque_center(dq);
+	return data;
+}
+/*
+ * Returns the number of elements in the deque
+ */
+size_t Deque_getSize(Deque* dq)
+{
+	if(dq == NULL) return 0;
+	return dq->size;
+}
+/*
+ * Returns a pointer to the element at position index
+ */
+E* Deque_getAt(Deque* dq, size_t index)
+{
+	assert(dq != NULL);
+	assert(index < dq->size);
+	size_t position = dq->head + index;
+	return &dq->map[position / DEQUE_BLOCK_SIZE][position % DEQUE_BLOCK_SIZE];
+}
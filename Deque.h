@@ -0,0 +1,144 @@
+/*
+ * Deque - A double-ended queue of fixed-size blocks, for lists that only
+ * ever change at their ends
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stddef.h>
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing Deque.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+#define DEQUE_BLOCK_SIZE 256	// E's per block, a power of 2
+#define DEQUE_MAP_SIZE 8		// Default initial number of block slots
+
+/*
+ * Traverses the deque from head to tail, a block at a time
+ * Usage:
+ * DequeCursor cursor;
+ * DEQUE_TRAVERSAL(deque, cursor)
+ * {
+ *      [this code gets executed deque->size times]
+ *      [and *cursor.data is the current element]
+ * }
+ */
+#define DEQUE_TRAVERSAL(DQ, CURSOR)										\
+	for(CURSOR = Deque_begin(DQ); CURSOR.remaining > 0; Deque_advance(&CURSOR))
+
+/*
+ * A Deque keeps its elements in blocks of DEQUE_BLOCK_SIZE E's, and a map
+ * of pointers to those blocks. The elements sit in the global positions
+ * head to head + size - 1, position p being slot p % DEQUE_BLOCK_SIZE of
+ * block p / DEQUE_BLOCK_SIZE, so every push and pop is a couple of
+ * arithmetic operations and a store, and walking the deque reads whole
+ * blocks in order. Only blocks holding elements are allocated.
+ * A block that empties is kept as the spare and handed out again before
+ * anything is allocated, and the block pointers are moved back to the
+ * middle of the map when one end runs out of room, so a deque used as a
+ * queue or a stack stops allocating once it has reached its working size.
+ * The map doubles when more than half of it is in use.
+ */
+typedef struct
+{
+	E** map;		// block pointers, NULL for a block holding nothing
+	size_t mapSize;	// number of block slots
+	size_t head;	// position of the head
+	size_t size;	// number of elements
+	E* spare;		// an emptied block kept for the next one needed
+}Deque;
+
+/*
+ * A DequeCursor walks the elements of a Deque from head to tail: data
+ * points at the current element and remaining counts it and every element
+ * after it. It stays valid only as long as nothing is pushed or popped.
+ */
+typedef struct
+{
+	E* data;
+	E* blockEnd;
+	E** block;
+	size_t remaining;
+}DequeCursor;
+
+/*
+ * Allocates an empty Deque. Returns NULL on failure.
+ */
+Deque* Deque_create();
+/*
+ * Deallocates a Deque and every block it holds.
+ */
+void Deque_free(Deque* dq);
+/*
+ * Adds an entry to the tail end of the deque. Nonzero on failure.
+ */
+int Deque_pushTail(Deque* dq, E data);
+/*
+ * Adds an entry to the head end of the deque. Nonzero on failure.
+ */
+int Deque_pushHead(Deque* dq, E data);
+/*
+ * Pops and returns the tail off the deque, which must not be empty.
+ */
+E Deque_popTail(Deque* dq);
+/*
+ * Pops and returns the head off the deque, which must not be empty.
+ */
+E Deque_popHead(Deque* dq);
+/*
+ * Returns the number of elements in the deque.
+ */
+size_t Deque_getSize(Deque* dq);
+/*
+ * Returns a pointer to the element at position index, 0 being the head,
+ * which must be less than the size of the deque. O(1).
+ */
+E* Deque_getAt(Deque* dq, size_t index);
+
+/*
+ * Returns a cursor at the head of the deque.
+ */
+static inline DequeCursor Deque_begin(const Deque* dq)
+{
+	DequeCursor cursor;
+	cursor.remaining = dq->size;
+	if(dq->size == 0)
+	{
+		cursor.data = NULL;
+		cursor.blockEnd = NULL;
+		cursor.block = NULL;
+		return cursor;
+	}
+	cursor.block = &dq->map[dq->head / DEQUE_BLOCK_SIZE];
+	cursor.data = *cursor.block + dq->head % DEQUE_BLOCK_SIZE;
+	cursor.blockEnd = *cursor.block + DEQUE_BLOCK_SIZE;
+	return cursor;
+}
+/*
+ * Moves a cursor to the next element, hopping to the next block at the end
+ * of this one.
+ */
+static inline void Deque_advance(DequeCursor* cursor)
+{
+	if(--cursor->remaining == 0) return;
+	if(++cursor->data == cursor->blockEnd)
+	{
+		cursor->block++;
+		cursor->data = *cursor->block;
+		cursor->blockEnd = cursor->data + DEQUE_BLOCK_SIZE;
+	}
+}
+
+#endif
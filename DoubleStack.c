@@ -1,80 +1,187 @@
 /*
  * DoubleStack - a stack of Doubles, great for a calculator
- * implemented in an array, written "java style"
+ * implemented in a growable array, written "java style"
  * Version: 2.09.2009
  * Author: Yama H
  */
 #include "DoubleStack.h"
 #include <stdlib.h>
+#include <string.h>
 /*
- * Saves contents of DoubleStack into a preallocated array and returns the
- * number of elements copied.
+ * Resizes the array of the DoubleStack to capacity values.
+ * Nonzero on failure, or if the array's size in bytes would overflow.
  */
-int DoubleStack_save(double* array)
+static int DoubleStack_resize(DoubleStack* ds, size_t capacity)
 {
-	int i = 0;
-	while(i < DoubleStack_index)
+	if(capacity > (size_t)-1 / sizeof(double))
+	{
+		CONTAINER_STATS_ADD(ds, overflows, 1);
+		return 1;
+	}
+	double* values = (double*)realloc(ds->values, capacity * sizeof(double));
+	CONTAINER_STATS_ADD(ds, allocations, 1);
+	if(values == NULL)
 	{
-		array[i] = DoubleStack_values[i];
-		i++;
+		CONTAINER_STATS_ADD(ds, overflows, 1);
+		return 1;
 	}
-	return i;
+	ds->values = values;
+	ds->capacity = capacity;
+	return 0;
 }
 /*
- * Loads an array of elements doubles into the DoubleStack.
+ * Allocates an empty DoubleStack with room for capacity values.
+ * Returns NULL on failure.
  */
-void DoubleStack_load(double* array, int elements)
+DoubleStack* DoubleStack_create(size_t capacity)
 {
-	elements += DoubleStack_index;
-	while(DoubleStack_index < elements)
+	DoubleStack* ds = (DoubleStack*)malloc(sizeof(DoubleStack));
+	if(ds == NULL) return NULL;
+	ds->values = NULL;
+	ds->capacity = 0;
+	CONTAINER_STATS_RESET(ds);
+	if(DoubleStack_resize(ds, capacity ? capacity : DOUBLESTACK_SIZE))
 	{
-		DoubleStack_values[DoubleStack_index] = array[DoubleStack_index];
-		DoubleStack_index++;
+		free(ds);
+		return NULL;
 	}
+	DoubleStack_init(ds);
+	return ds;
+}
+/*
+ * Empties the DoubleStack and clears its flags
+ */
+void DoubleStack_init(DoubleStack* ds)
+{
+	ds->index = 0;
+	ds->overflow = 0;
+	ds->underflow = 0;
+}
+/*
+ * Deallocates a DoubleStack
+ */
+void DoubleStack_free(DoubleStack* ds)
+{
+	if(ds == NULL) return;
+	free(ds->values);
+	free(ds);
 }
 /*
- * Initializes values of the DoubleStack
+ * Saves contents of DoubleStack into a preallocated array and returns the
+ * number of elements copied.
  */
-void DoubleStack_init()
+size_t DoubleStack_save(DoubleStack* ds, double* array)
 {
-	DoubleStack_index = 0;
-	DoubleStack_overflow = 0;
-	DoubleStack_underflow = 0;
-	DoubleStack_values = (double*)realloc(DoubleStack_values,
-			DOUBLESTACK_SIZE * sizeof(double));
+	memcpy(array, ds->values, ds->index * sizeof(double));
+	return ds->index;
 }
 /*
- * Pushes a value onto the DoubleStack
+ * Pushes an array of elements doubles onto the DoubleStack.
+ * Nonzero on failure.
  */
-void DoubleStack_push(double val)
+int DoubleStack_load(DoubleStack* ds, const double* array, size_t elements)
 {
-	DoubleStack_underflow = 0;
-	if(DoubleStack_index < DOUBLESTACK_SIZE)
-		DoubleStack_values[DoubleStack_index++] = val;
-	else
-		DoubleStack_overflow = 1;
+	if(elements > (size_t)-1 - ds->index || DoubleStack_reserve(ds, ds->index + elements))
+	{
+		ds->overflow = 1;
+		return 1;
+	}
+	memcpy(ds->values + ds->index, array, elements * sizeof(double));
+	ds->index += elements;
+	CONTAINER_STATS_PEAK(ds, ds->index);
+	ds->underflow = 0;
+	return 0;
+}
+/*
+ * Pushes a value onto the DoubleStack, doubling its array when it's full.
+ * Nonzero on failure.
+ */
+int DoubleStack_push(DoubleStack* ds, double val)
+{
+	ds->underflow = 0;
+	if(ds->index == ds->capacity &&
+			DoubleStack_resize(ds, ds->capacity ? ds->capacity * 2 : DOUBLESTACK_SIZE))
+	{
+		ds->overflow = 1;
+		return 1;
+	}
+	ds->values[ds->index++] = val;
+	CONTAINER_STATS_PEAK(ds, ds->index);
+	return 0;
 }
 /*
  * Pops a value from the DoubleStack
  */
-double DoubleStack_pop()
+double DoubleStack_pop(DoubleStack* ds)
 {
-	DoubleStack_overflow = 0;
-	if(DoubleStack_index == 0)
+	ds->overflow = 0;
+	if(ds->index == 0)
 	{
-		DoubleStack_underflow = 1;
+		ds->underflow = 1;
+		CONTAINER_STATS_ADD(ds, underflows, 1);
 		return 0;
 	}
-	return DoubleStack_values[--DoubleStack_index];
+	return ds->values[--ds->index];
 }
 /*
  * Reads the value on the top of the DoubleStack
  */
-double DoubleStack_peek()
+double DoubleStack_peek(DoubleStack* ds)
 {
-	if(DoubleStack_index == 0)
+	if(ds->index == 0)
 	{
 		return 0;
 	}
-	return DoubleStack_values[DoubleStack_index-1];
+	return ds->values[ds->index-1];
+}
+/*
+ * Returns the number of values on the DoubleStack
+ */
+size_t DoubleStack_getSize(DoubleStack* ds)
+{
+	if(ds == NULL) return 0;
+	return ds->index;
+}
+/*
+ * Makes sure the DoubleStack has room for at least capacity values, growing
+ * it geometrically. Nonzero on failure.
+ */
+int DoubleStack_reserve(DoubleStack* ds, size_t capacity)
+{
+	if(capacity <= ds->capacity) return 0;
+	size_t newCapacity = ds->capacity ? ds->capacity : DOUBLESTACK_SIZE;
+	while(newCapacity < capacity)
+	{
+		if(newCapacity > ((size_t)-1 / sizeof(double)) / 2) return 1;
+		newCapacity *= 2;
+	}
+	return DoubleStack_resize(ds, newCapacity);
+}
+/*
+ * Gives back the room the DoubleStack isn't using (keeping room for at least
+ * one value). Nonzero on failure.
+ */
+int DoubleStack_shrink(DoubleStack* ds)
+{
+	size_t capacity = ds->index ? ds->index : 1;
+	if(capacity == ds->capacity) return 0;
+	return DoubleStack_resize(ds, capacity);
+}
+/*
+ * Copies the counters of the DoubleStack into stats. Nonzero if they're
+ * compiled out.
+ */
+int DoubleStack_getStats(DoubleStack* ds, ContainerStats* stats)
+{
+	if(ds == NULL || stats == NULL) return 1;
+	return CONTAINER_STATS_GET(ds, stats);
+}
+/*
+ * Zeroes the counters of the DoubleStack
+ */
+void DoubleStack_resetStats(DoubleStack* ds)
+{
+	if(ds == NULL) return;
+	CONTAINER_STATS_RESET(ds);
+	CONTAINER_STATS_PEAK(ds, ds->index);
 }
@@ -1,39 +1,86 @@
 /**
  * Interface for a DoubleStack
  */
-#define DOUBLESTACK_SIZE 64	// Max size of stack
+#include <stddef.h>
+#include "ContainerStats.h"
 
-// Array to contain values
-double* DoubleStack_values;
-// index of stack array
-int DoubleStack_index;
-// overflow boolean
-int DoubleStack_overflow;
-// underflow boolean
-int DoubleStack_underflow;
+#define DOUBLESTACK_SIZE 64	// Default initial capacity of a stack
 
 /*
- * Saves contents of DoubleStack into a preallocated array and returns the
- * number of elements copied.
+ * A DoubleStack is a growable array of doubles with the top at
+ * values[index-1]. Any number of them can exist at once.
+ * The array doubles in size whenever it runs out of room, so pushing is
+ * amortized O(1). overflow is set when a push fails because the array
+ * couldn't grow, and underflow when popping an empty stack; each is cleared
+ * by the next push or pop.
  */
-int DoubleStack_save(double* array);
+typedef struct
+{
+	double* values;	// Array to contain values
+	size_t index;	// index of stack array
+	size_t capacity;	// room in values
+	int overflow;	// overflow boolean
+	int underflow;	// underflow boolean
+	CONTAINER_STATS_MEMBER	// only with -DCONTAINER_STATS, see ContainerStats.h
+}DoubleStack;
+
+/*
+ * Allocates an empty DoubleStack with room for capacity values
+ * (DOUBLESTACK_SIZE if capacity is 0). Returns NULL on failure.
+ */
+DoubleStack* DoubleStack_create(size_t capacity);
+/*
+ * Empties the DoubleStack and clears its flags, keeping its capacity.
+ */
+void DoubleStack_init(DoubleStack* ds);
+/*
+ * Deallocates a DoubleStack.
+ */
+void DoubleStack_free(DoubleStack* ds);
+/*
+ * Saves contents of DoubleStack into a preallocated array, bottom first,
+ * and returns the number of elements copied.
+ */
+size_t DoubleStack_save(DoubleStack* ds, double* array);
+/*
+ * Pushes an array of elements doubles onto the DoubleStack, so that the
+ * last one ends up on top. Nonzero on failure.
+ */
+int DoubleStack_load(DoubleStack* ds, const double* array, size_t elements);
+/*
+ * Pushes a value onto the stack, growing it if need be.
+ * Nonzero on failure.
+ */
+int DoubleStack_push(DoubleStack* ds, double value);
+/*
+ * Pops a value off of the stack. Returns 0 if it's empty.
+ */
+double DoubleStack_pop(DoubleStack* ds);
+/*
+ * Returns the value on top of the stack. Returns 0 if it's empty.
+ */
+double DoubleStack_peek(DoubleStack* ds);
 /*
- * Loads an array of elements doubles into the DoubleStack.
+ * Returns the number of values on the stack.
  */
-void DoubleStack_load(double* array, int elements);
+size_t DoubleStack_getSize(DoubleStack* ds);
 /*
- * Initializes values of the DoubleStack.
+ * Makes sure the stack has room for at least capacity values.
+ * Nonzero on failure.
  */
-void DoubleStack_init();
+int DoubleStack_reserve(DoubleStack* ds, size_t capacity);
 /*
- * Pushes a value onto the stack.
+ * Gives back the room the stack isn't using. Nonzero on failure.
  */
-void DoubleStack_push(double value);
+int DoubleStack_shrink(DoubleStack* ds);
 /*
- * Pops a value off of the stack.
+ * Copies what the stack has counted since it was created or last reset into
+ * stats. Nonzero (and stats zeroed) if the program wasn't compiled with
+ * CONTAINER_STATS.
  */
-double DoubleStack_pop();
+int DoubleStack_getStats(DoubleStack* ds, ContainerStats* stats);
 /*
- * Returns the value on top of the stack.
+ * Zeroes the counters of the stack, with peakSize starting over from its
+ * size.
  */
-double DoubleStack_peek();
+void DoubleStack_resetStats(DoubleStack* ds);
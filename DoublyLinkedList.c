@@ -10,9 +10,645 @@
  * Revision: 5.15.2011
  */
 #include <stdlib.h>
+#include <string.h>
+#include <float.h>
 #include <assert.h>
 #include "DoublyLinkedList.h"
 
+/*
+ * Allocates a node for dll, from its pool if it has one.
+ */
+static DLLNode* DoublyLinkedList_allocNode(DoublyLinkedList* dll)
+{
+	DLLNode* node;
+	if(dll->pool != NULL) node = DLLNodePool_alloc(dll->pool);
+	else node = (DLLNode*)malloc(sizeof(DLLNode));
+	CONTAINER_STATS_ADD(dll, allocations, 1);
+	if(node == NULL) CONTAINER_STATS_ADD(dll, overflows, 1);
+	return node;
+}
+/*
+ * Deallocates a node of dll, giving it back to its pool if it has one.
+ */
+static void DoublyLinkedList_freeNode(DoublyLinkedList* dll, DLLNode* node)
+{
+	if(dll->pool != NULL) DLLNodePool_release(dll->pool, node);
+	else free(node);
+	CONTAINER_STATS_ADD(dll, frees, 1);
+}
+/*
+ * Compares two values with dll->compare if it's been implemented, or with
+ * '<' and '>' otherwise.
+ */
+static int DoublyLinkedList_compareValues(DoublyLinkedList* dll, E val1, E val2)
+{
+	if(dll->compare)
+	{
+		CONTAINER_STATS_ADD(dll, compares, 1);
+		return dll->compare(val1, val2);
+	}
+	return (val1 > val2) - (val1 < val2);
+}
+
+/*
+ * A DLLSkipNode is one tower of the skip-list index, pointing at the DLLNode
+ * it stands for. The header tower has no node and DLL_SKIP_MAXLEVEL levels.
+ */
+#define DLL_SKIP_MAXLEVEL 32
+typedef struct DLLSkipNode
+{
+	DLLNode* node;
+	int level;
+	struct DLLSkipNode* forward[];
+}DLLSkipNode;
+typedef struct DLLSkipIndex
+{
+	DLLSkipNode* header;
+	int level;
+	unsigned long long seed;
+}DLLSkipIndex;
+
+/*
+ * Allocates a tower of the given height for node.
+ */
+static DLLSkipNode* DoublyLinkedList_skipNode(DLLNode* node, int level)
+{
+	DLLSkipNode* x = (DLLSkipNode*)malloc(sizeof(DLLSkipNode) +
+			level * sizeof(DLLSkipNode*));
+	if(x == NULL) return NULL;
+	x->node = node;
+	x->level = level;
+	int i;
+	for(i = 0; i < level; i++)
+		x->forward[i] = NULL;
+	return x;
+}
+/*
+ * Picks a tower height, each extra level having a 1 in 4 chance.
+ */
+static int DoublyLinkedList_skipLevel(DLLSkipIndex* index)
+{
+	int level = 1;
+	while(level < DLL_SKIP_MAXLEVEL)
+	{
+		// xorshift64
+		index->seed ^= index->seed << 13;
+		index->seed ^= index->seed >> 7;
+		index->seed ^= index->seed << 17;
+		if(index->seed & 3) break;
+		level++;
+	}
+	return level;
+}
+/*
+ * Returns the last tower whose value is less than value (or not greater
+ * than value if inclusive is set), filling update with the last such tower
+ * on every level if it isn't NULL.
+ */
+static DLLSkipNode* DoublyLinkedList_skipSearch(DoublyLinkedList* dll, E value,
+		int inclusive, DLLSkipNode** update)
+{
+	DLLSkipNode* x = dll->skipIndex->header;
+	int i;
+	for(i = dll->skipIndex->level - 1; i >= 0; i--)
+	{
+		while(x->forward[i] != NULL)
+		{
+			CONTAINER_STATS_ADD(dll, nodesVisited, 1);
+			int cmp = DoublyLinkedList_compareValues(dll,
+					x->forward[i]->node->data, value);
+			if(cmp > 0 || (cmp == 0 && !inclusive)) break;
+			x = x->forward[i];
+		}
+		if(update != NULL) update[i] = x;
+	}
+	return x;
+}
+/*
+ * Adds a tower for node right after the towers in update.
+ * Nonzero on failure.
+ */
+static int DoublyLinkedList_skipLink(DLLSkipIndex* index, DLLNode* node,
+		DLLSkipNode** update)
+{
+	int level = DoublyLinkedList_skipLevel(index);
+	DLLSkipNode* x = DoublyLinkedList_skipNode(node, level);
+	if(x == NULL) return 1;
+	int i;
+	for(i = index->level; i < level; i++)
+		update[i] = index->header;
+	if(level > index->level) index->level = level;
+	for(i = 0; i < level; i++)
+	{
+		x->forward[i] = update[i]->forward[i];
+		update[i]->forward[i] = x;
+	}
+	return 0;
+}
+/*
+ * Removes the tower of node from the skip-list index of dll, if it has one.
+ */
+static void DoublyLinkedList_skipUnlink(DoublyLinkedList* dll, DLLNode* node)
+{
+	DLLSkipIndex* index = dll->skipIndex;
+	if(index == NULL) return;
+	DLLSkipNode* update[DLL_SKIP_MAXLEVEL];
+	DLLSkipNode* x = DoublyLinkedList_skipSearch(dll, node->data, 0, update);
+	int i;
+	// walk past towers of equal values until we reach the one for node
+	x = x->forward[0];
+	while(x != NULL && x->node != node)
+	{
+		for(i = 0; i < x->level; i++)
+			update[i] = x;
+		x = x->forward[0];
+	}
+	if(x == NULL) return;
+	for(i = 0; i < x->level; i++)
+		update[i]->forward[i] = x->forward[i];
+	while(index->level > 1 && index->header->forward[index->level-1] == NULL)
+		index->level--;
+	free(x);
+}
+/*
+ * Deallocates every tower of a skip-list index, keeping the header.
+ */
+static void DoublyLinkedList_skipClear(DLLSkipIndex* index)
+{
+	DLLSkipNode* x = index->header->forward[0];
+	while(x != NULL)
+	{
+		DLLSkipNode* next = x->forward[0];
+		free(x);
+		x = next;
+	}
+	int i;
+	for(i = 0; i < DLL_SKIP_MAXLEVEL; i++)
+		index->header->forward[i] = NULL;
+	index->level = 1;
+}
+/*
+ * A DLLHashSlot is one slot of the hash index, holding a node and the hash
+ * of its value. Slots are probed linearly and an empty slot has no node.
+ */
+typedef struct
+{
+	DLLNode* node;
+	size_t hash;
+}DLLHashSlot;
+typedef struct DLLHashIndex
+{
+	DLLHashSlot* slots;
+	size_t capacity;	// always a power of 2
+	size_t count;
+	size_t (*hash)(E value);
+}DLLHashIndex;
+
+/*
+ * Puts node into the slots of index, which must have room for it.
+ */
+static void DoublyLinkedList_hashPlace(DLLHashIndex* index, DLLNode* node, size_t hash)
+{
+	size_t mask = index->capacity - 1;
+	size_t i = hash & mask;
+	while(index->slots[i].node != NULL)
+		i = (i + 1) & mask;
+	index->slots[i].node = node;
+	index->slots[i].hash = hash;
+	index->count++;
+}
+/*
+ * Moves every node of index into a new table of the given capacity.
+ * Nonzero on failure.
+ */
+static int DoublyLinkedList_hashResize(DLLHashIndex* index, size_t capacity)
+{
+	DLLHashSlot* slots = (DLLHashSlot*)calloc(capacity, sizeof(DLLHashSlot));
+	if(slots == NULL) return 1;
+	DLLHashSlot* old = index->slots;
+	size_t oldCapacity = index->capacity, i;
+	index->slots = slots;
+	index->capacity = capacity;
+	index->count = 0;
+	for(i = 0; i < oldCapacity; i++)
+		if(old[i].node != NULL)
+			DoublyLinkedList_hashPlace(index, old[i].node, old[i].hash);
+	free(old);
+	return 0;
+}
+/*
+ * Adds a freshly linked node to the hash index of dll, if it has one.
+ */
+static void DoublyLinkedList_hashInsert(DoublyLinkedList* dll, DLLNode* node)
+{
+	DLLHashIndex* index = dll->hashIndex;
+	if(index == NULL) return;
+	// keep the table at most half full
+	if((index->count + 1) * 2 > index->capacity &&
+			DoublyLinkedList_hashResize(index, index->capacity * 2))
+	{
+		DoublyLinkedList_disableHashIndex(dll);
+		return;
+	}
+	DoublyLinkedList_hashPlace(index, node, index->hash(node->data));
+}
+/*
+ * Takes a node about to be unlinked out of the hash index of dll, if it has
+ * one. Later slots are shifted back so that no probe sequence is broken.
+ */
+static void DoublyLinkedList_hashRemove(DoublyLinkedList* dll, DLLNode* node)
+{
+	DLLHashIndex* index = dll->hashIndex;
+	if(index == NULL) return;
+	size_t mask = index->capacity - 1;
+	size_t i = index->hash(node->data) & mask;
+	while(index->slots[i].node != node)
+	{
+		if(index->slots[i].node == NULL) return;
+		i = (i + 1) & mask;
+	}
+	size_t j = i;
+	for(;;)
+	{
+		j = (j + 1) & mask;
+		if(index->slots[j].node == NULL) break;
+		size_t k = index->slots[j].hash & mask;
+		// move slot j back into the hole at i unless its home lies in (i, j]
+		if((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j)))
+		{
+			index->slots[i] = index->slots[j];
+			i = j;
+		}
+	}
+	index->slots[i].node = NULL;
+	index->count--;
+}
+/*
+ * A DLLRankNode is one node of the rank index: a treap whose in-order walk
+ * is the list order, so each node only needs to know how many nodes its
+ * subtree holds to find positions. Priorities are random and a parent's is
+ * never lower than its children's, which keeps the tree O(log n) deep.
+ */
+typedef struct DLLRankNode
+{
+	struct DLLRankNode* parent;
+	struct DLLRankNode* left;
+	struct DLLRankNode* right;
+	DLLNode* node;
+	size_t count;		// nodes in this subtree
+	unsigned int priority;
+}DLLRankNode;
+typedef struct DLLRankIndex
+{
+	DLLRankNode* root;
+	unsigned long long seed;
+}DLLRankIndex;
+
+/*
+ * Returns the number of nodes in the subtree at x.
+ */
+static size_t DoublyLinkedList_rankCount(DLLRankNode* x)
+{
+	return x != NULL ? x->count : 0;
+}
+/*
+ * Recounts the nodes in the subtree at x from its children.
+ */
+static void DoublyLinkedList_rankRecount(DLLRankNode* x)
+{
+	x->count = 1 + DoublyLinkedList_rankCount(x->left) +
+			DoublyLinkedList_rankCount(x->right);
+}
+/*
+ * Picks a random priority.
+ */
+static unsigned int DoublyLinkedList_rankPriority(DLLRankIndex* index)
+{
+	// xorshift64
+	index->seed ^= index->seed << 13;
+	index->seed ^= index->seed >> 7;
+	index->seed ^= index->seed << 17;
+	return (unsigned int)(index->seed >> 32);
+}
+/*
+ * Rotates x above its parent, keeping the in-order walk the same.
+ */
+static void DoublyLinkedList_rankRotateUp(DLLRankIndex* index, DLLRankNode* x)
+{
+	DLLRankNode* p = x->parent;
+	if(x == p->left)
+	{
+		p->left = x->right;
+		if(x->right != NULL) x->right->parent = p;
+		x->right = p;
+	}
+	else
+	{
+		p->right = x->left;
+		if(x->left != NULL) x->left->parent = p;
+		x->left = p;
+	}
+	x->parent = p->parent;
+	if(p->parent == NULL) index->root = x;
+	else if(p->parent->left == p) p->parent->left = x;
+	else p->parent->right = x;
+	p->parent = x;
+	DoublyLinkedList_rankRecount(p);
+	DoublyLinkedList_rankRecount(x);
+}
+/*
+ * Puts the rank node x of a freshly linked node into the tree, right next
+ * to the rank node of one of its neighbours.
+ */
+static void DoublyLinkedList_rankAttach(DLLRankIndex* index, DLLRankNode* x)
+{
+	DLLNode* node = x->node;
+	x->left = NULL;
+	x->right = NULL;
+	x->count = 1;
+	DLLRankNode* p = NULL;
+	if(node->prev != NULL)
+	{
+		// x goes right after the rank node of prev
+		p = node->prev->rank;
+		if(p->right == NULL) p->right = x;
+		else
+		{
+			for(p = p->right; p->left != NULL; p = p->left);
+			p->left = x;
+		}
+	}
+	else if(node->next != NULL)
+	{
+		// x goes right before the rank node of next
+		p = node->next->rank;
+		if(p->left == NULL) p->left = x;
+		else
+		{
+			for(p = p->left; p->right != NULL; p = p->right);
+			p->right = x;
+		}
+	}
+	else index->root = x;
+	x->parent = p;
+	for(; p != NULL; p = p->parent)
+		p->count++;
+	while(x->parent != NULL && x->parent->priority < x->priority)
+		DoublyLinkedList_rankRotateUp(index, x);
+}
+/*
+ * Takes the rank node x out of the tree, by rotating it down until it has
+ * at most one child, without deallocating it.
+ */
+static void DoublyLinkedList_rankDetach(DLLRankIndex* index, DLLRankNode* x)
+{
+	while(x->left != NULL && x->right != NULL)
+		DoublyLinkedList_rankRotateUp(index, x->left->priority > x->right->priority ?
+				x->left : x->right);
+	DLLRankNode* child = x->left != NULL ? x->left : x->right;
+	DLLRankNode* p = x->parent;
+	if(child != NULL) child->parent = p;
+	if(p == NULL) index->root = child;
+	else if(p->left == x) p->left = child;
+	else p->right = child;
+	for(; p != NULL; p = p->parent)
+		p->count--;
+}
+/*
+ * Adds a freshly linked node to the rank index of dll, if it has one.
+ */
+static void DoublyLinkedList_rankLink(DoublyLinkedList* dll, DLLNode* node)
+{
+	DLLRankIndex* index = dll->rankIndex;
+	if(index == NULL) return;
+	DLLRankNode* x = (DLLRankNode*)malloc(sizeof(DLLRankNode));
+	if(x == NULL)
+	{
+		DoublyLinkedList_disableRankIndex(dll);
+		return;
+	}
+	x->node = node;
+	x->priority = DoublyLinkedList_rankPriority(index);
+	node->rank = x;
+	DoublyLinkedList_rankAttach(index, x);
+}
+/*
+ * Takes a node about to be unlinked out of the rank index of dll, if it has
+ * one.
+ */
+static void DoublyLinkedList_rankUnlink(DoublyLinkedList* dll, DLLNode* node)
+{
+	if(dll->rankIndex == NULL) return;
+	DoublyLinkedList_rankDetach(dll->rankIndex, node->rank);
+	free(node->rank);
+}
+/*
+ * Deallocates every node of a rank index, rotating left children up so that
+ * no stack is needed.
+ */
+static void DoublyLinkedList_rankClear(DLLRankIndex* index)
+{
+	DLLRankNode* x = index->root;
+	while(x != NULL)
+	{
+		DLLRankNode* y;
+		if(x->left != NULL)
+		{
+			y = x->left;
+			x->left = y->right;
+			y->right = x;
+		}
+		else
+		{
+			y = x->right;
+			free(x);
+		}
+		x = y;
+	}
+	index->root = NULL;
+}
+/*
+ * Rebuilds the rank index of dll, if it has one, after its nodes have been
+ * reordered wholesale.
+ */
+static void DoublyLinkedList_rankRebuild(DoublyLinkedList* dll)
+{
+	if(dll->rankIndex == NULL) return;
+	DoublyLinkedList_disableRankIndex(dll);
+	DoublyLinkedList_enableRankIndex(dll);
+}
+/*
+ * Merges two ascending, NULL-terminated chains of nodes (following next
+ * only) into one and returns its first node. On ties, nodes of a come first.
+ */
+static DLLNode* DoublyLinkedList_mergeChains(DoublyLinkedList* dll, DLLNode* a, DLLNode* b)
+{
+	DLLNode head;
+	DLLNode* tail = &head;
+	while(a != NULL && b != NULL)
+	{
+		if(DoublyLinkedList_compareValues(dll, b->data, a->data) < 0)
+		{
+			tail->next = b;
+			b = b->next;
+		}
+		else
+		{
+			tail->next = a;
+			a = a->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = a != NULL ? a : b;
+	return head.next;
+}
+/*
+ * Sorts a NULL-terminated chain of nodes (following next only) and returns
+ * its first node. Runs of 1, 2, 4, ... nodes are kept in bins and merged
+ * like a binary counter, so no extra memory is needed.
+ */
+static DLLNode* DoublyLinkedList_sortChain(DoublyLinkedList* dll, DLLNode* chain)
+{
+	DLLNode* bins[sizeof(size_t) * 8 + 1] = { NULL };
+	int i, top = 0;
+	while(chain != NULL)
+	{
+		DLLNode* carry = chain;
+		chain = chain->next;
+		carry->next = NULL;
+		// bins further up always hold earlier nodes
+		for(i = 0; bins[i] != NULL; i++)
+		{
+			carry = DoublyLinkedList_mergeChains(dll, bins[i], carry);
+			bins[i] = NULL;
+		}
+		bins[i] = carry;
+		if(i >= top) top = i + 1;
+	}
+	DLLNode* result = NULL;
+	for(i = 0; i < top; i++)
+		if(bins[i] != NULL)
+			result = DoublyLinkedList_mergeChains(dll, bins[i], result);
+	return result;
+}
+/*
+ * Links node into dll right before at (or at the tail if at is NULL),
+ * without touching the indexes.
+ */
+static void DoublyLinkedList_linkBefore(DoublyLinkedList* dll, DLLNode* node, DLLNode* at)
+{
+	node->list = dll;
+	node->next = at;
+	node->prev = at != NULL ? at->prev : dll->tail;
+	if(node->prev != NULL) node->prev->next = node;
+	else dll->head = node;
+	if(at != NULL) at->prev = node;
+	else dll->tail = node;
+	dll->size++;
+	CONTAINER_STATS_PEAK(dll, dll->size);
+}
+/*
+ * Makes dll consist of the NULL-terminated chain starting at head, fixing up
+ * the prev and list pointers along the way.
+ */
+static void DoublyLinkedList_relink(DoublyLinkedList* dll, DLLNode* head)
+{
+	DLLNode* prev = NULL, *node;
+	for(node = head; node != NULL; node = node->next)
+	{
+		node->prev = prev;
+		node->list = dll;
+		prev = node;
+	}
+	dll->head = head;
+	dll->tail = prev;
+}
+/*
+ * Allocates an empty DLLNodePool that grabs nodesPerSlab nodes at a time
+ * (DLLNODEPOOL_DEFAULT_SLAB if nodesPerSlab is 0). Returns NULL on failure.
+ */
+DLLNodePool* DLLNodePool_create(size_t nodesPerSlab)
+{
+	DLLNodePool* pool = (DLLNodePool*)malloc(sizeof(DLLNodePool));
+	if(pool == NULL) return NULL;
+	pool->freeList = NULL;
+	pool->slabs = NULL;
+	pool->slabSize = nodesPerSlab ? nodesPerSlab : DLLNODEPOOL_DEFAULT_SLAB;
+	pool->available = 0;
+	return pool;
+}
+/*
+ * Allocates a slab of count nodes and puts them all on the free list.
+ * Nonzero on failure.
+ */
+static int DLLNodePool_grow(DLLNodePool* pool, size_t count)
+{
+	// The first node of every slab is only used to chain the slabs
+	// together, so the rest stay properly aligned for E.
+	DLLNode* slab = (DLLNode*)malloc((count + 1) * sizeof(DLLNode));
+	if(slab == NULL) return 1;
+	slab->next = pool->slabs;
+	pool->slabs = slab;
+	size_t i;
+	for(i = count; i > 0; i--)
+	{
+		slab[i].next = pool->freeList;
+		pool->freeList = &slab[i];
+	}
+	pool->available += count;
+	return 0;
+}
+/*
+ * Hands out a node from the pool, allocating a new slab if the free list is
+ * empty. Returns NULL on failure.
+ */
+DLLNode* DLLNodePool_alloc(DLLNodePool* pool)
+{
+	assert(pool != NULL);
+	if(pool->freeList == NULL && DLLNodePool_grow(pool, pool->slabSize))
+		return NULL;
+	DLLNode* node = pool->freeList;
+	pool->freeList = node->next;
+	pool->available--;
+	return node;
+}
+/*
+ * Makes sure at least count nodes can be handed out without allocating.
+ * Nonzero on failure.
+ */
+int DLLNodePool_reserve(DLLNodePool* pool, size_t count)
+{
+	assert(pool != NULL);
+	if(pool->available >= count) return 0;
+	count -= pool->available;
+	return DLLNodePool_grow(pool, count > pool->slabSize ? count : pool->slabSize);
+}
+/*
+ * Gives a node back to the pool so it can be handed out again.
+ */
+void DLLNodePool_release(DLLNodePool* pool, DLLNode* node)
+{
+	assert(pool != NULL);
+	if(node == NULL) return;
+	node->next = pool->freeList;
+	pool->freeList = node;
+	pool->available++;
+}
+/*
+ * Releases every slab of the pool at once, along with the pool itself.
+ */
+void DLLNodePool_free(DLLNodePool* pool)
+{
+	if(pool == NULL) return;
+	DLLNode* slab = pool->slabs;
+	while(slab != NULL)
+	{
+		DLLNode* next = slab->next;
+		free(slab);
+		slab = next;
+	}
+	free(pool);
+}
 /*
  * Initializes a pre-allocated List and creates first node.
  */
@@ -20,13 +656,32 @@ void DoublyLinkedList_initialize(DoublyLinkedList* dll, E data, short int autoSo
 {
 	assert(dll != NULL);
 	dll->size = 1;
-	dll->head = (DLLNode*)malloc(sizeof(DLLNode));
+	CONTAINER_STATS_PEAK(dll, 1);
+	dll->head = DoublyLinkedList_allocNode(dll);
 	dll->head->data = data;
 	dll->head->prev = NULL;
 	dll->head->next = NULL;
 	dll->head->list = dll;
 	dll->sorted = autoSort;
 	dll->tail = dll->head;
+	DoublyLinkedList_hashInsert(dll, dll->head);
+	if(dll->rankIndex != NULL)
+	{
+		DoublyLinkedList_rankClear(dll->rankIndex);
+		DoublyLinkedList_rankLink(dll, dll->head);
+	}
+	if(dll->skipIndex != NULL)
+	{
+		// an empty list has an empty index, and an unsorted one keeps it so
+		DoublyLinkedList_skipClear(dll->skipIndex);
+		if(autoSort)
+		{
+			DLLSkipNode* update[DLL_SKIP_MAXLEVEL];
+			update[0] = dll->skipIndex->header;
+			if(DoublyLinkedList_skipLink(dll->skipIndex, dll->head, update))
+				DoublyLinkedList_disableSkipIndex(dll);
+		}
+	}
 }
 /*
  * Allocates an empty DoublyLinkedList
@@ -37,7 +692,24 @@ DoublyLinkedList* DoublyLinkedList_create()
 	dll->size = 0;
 	dll->head = NULL;
 	dll->tail = NULL;
+	dll->sorted = 0;
 	dll->compare = NULL;
+	dll->pool = NULL;
+	dll->skipIndex = NULL;
+	dll->hashIndex = NULL;
+	dll->rankIndex = NULL;
+	CONTAINER_STATS_RESET(dll);
+	return dll;
+}
+/*
+ * Allocates an empty DoublyLinkedList whose nodes come from pool instead of
+ * malloc(). The pool is not owned by the list and may be shared.
+ */
+DoublyLinkedList* DoublyLinkedList_createWithPool(DLLNodePool* pool)
+{
+	DoublyLinkedList* dll = DoublyLinkedList_create();
+	if(dll == NULL) return NULL;
+	dll->pool = pool;
 	return dll;
 }
 /*
@@ -80,16 +752,19 @@ E DoublyLinkedList_popTail(DoublyLinkedList* dll)
 	assert(dll != NULL);
 	assert(dll->size > 0);
 	E returnData = dll->tail->data;
+	DoublyLinkedList_skipUnlink(dll, dll->tail);
+	DoublyLinkedList_hashRemove(dll, dll->tail);
+	DoublyLinkedList_rankUnlink(dll, dll->tail);
 	if(dll->size == 1)
 	{
 		dll->head = NULL;
-		free(dll->tail);
+		DoublyLinkedList_freeNode(dll, dll->tail);
 		dll->tail = NULL;
 		dll->size--;
 		return returnData;
 	}
 	DLLNode* tmp = dll->tail->prev;
-	free(dll->tail);
+	DoublyLinkedList_freeNode(dll, dll->tail);
 	tmp->next = NULL;
 	if(tmp->prev != NULL) tmp->prev->next = tmp;
 	dll->tail = tmp;
@@ -104,16 +779,19 @@ E DoublyLinkedList_popHead(DoublyLinkedList* dll)
 	assert(dll != NULL);
 	assert(dll->size > 0);
 	E returnData = dll->head->data;
+	DoublyLinkedList_skipUnlink(dll, dll->head);
+	DoublyLinkedList_hashRemove(dll, dll->head);
+	DoublyLinkedList_rankUnlink(dll, dll->head);
 	if(dll->size == 1)
 	{
 		dll->tail = NULL;
-		free(dll->head);
+		DoublyLinkedList_freeNode(dll, dll->head);
 		dll->head = NULL;
 		dll->size--;
 		return returnData;
 	}
 	DLLNode* tmp = dll->head->next;
-	free(dll->head);
+	DoublyLinkedList_freeNode(dll, dll->head);
 	tmp->prev = NULL;
 	if(tmp->next != NULL) tmp->next->prev = tmp;
 	dll->head = tmp;
@@ -127,7 +805,11 @@ E DoublyLinkedList_popHead(DoublyLinkedList* dll)
 int DoublyLinkedList_remove(DLLNode* element)
 {
 	if(element == NULL) return 1;
-	if(element->list->size <= 0) return 1;
+	if(element->list->size <= 0)
+	{
+		CONTAINER_STATS_ADD(element->list, underflows, 1);
+		return 1;
+	}
 	if(element == element->list->head)
 	{
 		DoublyLinkedList_popHead(element->list);
@@ -138,10 +820,13 @@ int DoublyLinkedList_remove(DLLNode* element)
 		DoublyLinkedList_popTail(element->list);
 		return 0;
 	}
+	DoublyLinkedList_skipUnlink(element->list, element);
+	DoublyLinkedList_hashRemove(element->list, element);
+	DoublyLinkedList_rankUnlink(element->list, element);
 	element->next->prev = element->prev;
 	element->prev->next = element->next;
 	element->list->size--;
-	free(element);
+	DoublyLinkedList_freeNode(element->list, element);
 	return 0;
 }
 /*
@@ -150,11 +835,35 @@ int DoublyLinkedList_remove(DLLNode* element)
  */
 DLLNode* DoublyLinkedList_find(DoublyLinkedList* dll, E value)
 {
+	if(dll->hashIndex != NULL)
+	{
+		DLLHashIndex* index = dll->hashIndex;
+		size_t mask = index->capacity - 1;
+		size_t hash = index->hash(value);
+		size_t i;
+		for(i = hash & mask; index->slots[i].node != NULL; i = (i + 1) & mask)
+		{
+			CONTAINER_STATS_ADD(dll, nodesVisited, 1);
+			if(index->slots[i].hash == hash && !DoublyLinkedList_compareValues(
+					dll, index->slots[i].node->data, value))
+				return index->slots[i].node;
+		}
+		return NULL;
+	}
+	if(dll->skipIndex != NULL && dll->sorted)
+	{
+		DLLNode* node = DoublyLinkedList_lowerBound(dll, value);
+		if(node != NULL && !DoublyLinkedList_compareValues(dll, node->data, value))
+			return node;
+		return NULL;
+	}
 	DLLNode* frontPtr, *rearPtr;
 	DLL_DOUBLE_TRAVERSAL(dll, frontPtr, rearPtr)
 	{
+		CONTAINER_STATS_ADD(dll, nodesVisited, 2);
 		if(dll->compare)
 		{
+			CONTAINER_STATS_ADD(dll, compares, 2);
 			if(!dll->compare(frontPtr->data, value)) return frontPtr;
 			if(!dll->compare(rearPtr->data, value)) return rearPtr;
 		}
@@ -213,12 +922,25 @@ E DoublyLinkedList_getData(DLLNode node)
 }
 /*
  * Sets the data in a specified node in the list to a specified value, and
- * updates the node passed in. Nonzero on failure.
+ * updates the node passed in (and the hash and skip-list indexes, if there
+ * are any). Zero if node is null.
  */
 int DoublyLinkedList_setData(DLLNode* node, E data)
 {
 	if(node == NULL) return 0;
+	DoublyLinkedList* dll = node->list;
+	DoublyLinkedList_hashRemove(dll, node);
+	// the tower has to be found by the old value and filed under the new one
+	DoublyLinkedList_skipUnlink(dll, node);
 	node->data = data;
+	DoublyLinkedList_hashInsert(dll, node);
+	if(dll->skipIndex != NULL)
+	{
+		DLLSkipNode* update[DLL_SKIP_MAXLEVEL];
+		DoublyLinkedList_skipSearch(dll, data, 0, update);
+		if(DoublyLinkedList_skipLink(dll->skipIndex, node, update))
+			DoublyLinkedList_disableSkipIndex(dll);
+	}
 	return 1;
 }
 /*
@@ -238,18 +960,23 @@ int DoublyLinkedList_insertAfter(DLLNode* handle, E data)
 	assert(!handle->list->sorted);
 	if(handle->next == NULL && handle == handle->list->tail)
 	{
-		handle->next = (DLLNode*)malloc(sizeof(DLLNode));
+		handle->next = DoublyLinkedList_allocNode(handle->list);
+		if(handle->next == NULL) return 1;
 		handle->next->prev = handle;
 		handle->next->next = NULL;
 		handle->next->data = data;
 		handle->next->list = handle->list;
 		handle->list->tail = handle->next;
 		handle->list->size++;
+		CONTAINER_STATS_PEAK(handle->list, handle->list->size);
+		DoublyLinkedList_hashInsert(handle->list, handle->next);
+		DoublyLinkedList_rankLink(handle->list, handle->next);
 		return 0;
 	}
 	if(handle->next != NULL)
 	{
-		DLLNode* newNode = (DLLNode*)malloc(sizeof(DLLNode));
+		DLLNode* newNode = DoublyLinkedList_allocNode(handle->list);
+		if(newNode == NULL) return 1;
 		newNode->data = data;
 		newNode->prev = handle;
 		newNode->next = handle->next;
@@ -257,6 +984,9 @@ int DoublyLinkedList_insertAfter(DLLNode* handle, E data)
 		handle->next->prev = newNode;
 		handle->next = newNode;
 		handle->list->size++;
+		CONTAINER_STATS_PEAK(handle->list, handle->list->size);
+		DoublyLinkedList_hashInsert(handle->list, newNode);
+		DoublyLinkedList_rankLink(handle->list, newNode);
 		return 0;
 	}
 	return 1;
@@ -278,18 +1008,23 @@ int DoublyLinkedList_insertBefore(DLLNode* handle, E data)
 	assert(!handle->list->sorted);
 	if(handle->prev == NULL && handle == handle->list->head)
 	{
-		handle->prev = (DLLNode*)malloc(sizeof(DLLNode));
+		handle->prev = DoublyLinkedList_allocNode(handle->list);
+		if(handle->prev == NULL) return 1;
 		handle->prev->next = handle;
 		handle->prev->prev = NULL;
 		handle->prev->data = data;
 		handle->prev->list = handle->list;
 		handle->list->head = handle->prev;
 		handle->list->size++;
+		CONTAINER_STATS_PEAK(handle->list, handle->list->size);
+		DoublyLinkedList_hashInsert(handle->list, handle->prev);
+		DoublyLinkedList_rankLink(handle->list, handle->prev);
 		return 0;
 	}
 	if(handle->prev != NULL)
 	{
-		DLLNode* newNode = malloc(sizeof(DLLNode));
+		DLLNode* newNode = DoublyLinkedList_allocNode(handle->list);
+		if(newNode == NULL) return 1;
 		newNode->data = data;
 		newNode->next = handle;
 		newNode->prev = handle->prev;
@@ -297,10 +1032,57 @@ int DoublyLinkedList_insertBefore(DLLNode* handle, E data)
 		handle->prev->next = newNode;
 		handle->prev = newNode;
 		handle->list->size++;
+		CONTAINER_STATS_PEAK(handle->list, handle->list->size);
+		DoublyLinkedList_hashInsert(handle->list, newNode);
+		DoublyLinkedList_rankLink(handle->list, newNode);
 		return 0;
 	}
 	return 1;
 }
+/*
+ * Moves node to the head of its list by relinking it, so nothing is
+ * allocated or freed. Nonzero on failure.
+ * note: this method is disabled when autoSort is enabled
+ */
+int DoublyLinkedList_moveToHead(DLLNode* node)
+{
+	if(node == NULL) return 1;
+	DoublyLinkedList* dll = node->list;
+	assert(!dll->sorted);
+	if(node == dll->head) return 0;
+	if(dll->rankIndex != NULL) DoublyLinkedList_rankDetach(dll->rankIndex, node->rank);
+	node->prev->next = node->next;
+	if(node->next != NULL) node->next->prev = node->prev;
+	else dll->tail = node->prev;
+	node->prev = NULL;
+	node->next = dll->head;
+	dll->head->prev = node;
+	dll->head = node;
+	if(dll->rankIndex != NULL) DoublyLinkedList_rankAttach(dll->rankIndex, node->rank);
+	return 0;
+}
+/*
+ * Moves node to the tail of its list by relinking it, so nothing is
+ * allocated or freed. Nonzero on failure.
+ * note: this method is disabled when autoSort is enabled
+ */
+int DoublyLinkedList_moveToTail(DLLNode* node)
+{
+	if(node == NULL) return 1;
+	DoublyLinkedList* dll = node->list;
+	assert(!dll->sorted);
+	if(node == dll->tail) return 0;
+	if(dll->rankIndex != NULL) DoublyLinkedList_rankDetach(dll->rankIndex, node->rank);
+	node->next->prev = node->prev;
+	if(node->prev != NULL) node->prev->next = node->next;
+	else dll->head = node->next;
+	node->next = NULL;
+	node->prev = dll->tail;
+	dll->tail->next = node;
+	dll->tail = node;
+	if(dll->rankIndex != NULL) DoublyLinkedList_rankAttach(dll->rankIndex, node->rank);
+	return 0;
+}
 /*
  * Returns the number of size currently in the list.
  */
@@ -310,17 +1092,17 @@ size_t DoublyLinkedList_getSize(DoublyLinkedList* dll)
 	return dll->size;
 }
 /*
- * Empties and deallocates a DoublyLinkedList
+ * Empties and deallocates a DoublyLinkedList. If the list uses a pool, its
+ * nodes are given back to the pool, which stays alive.
  */
 void DoublyLinkedList_free(DoublyLinkedList* dll)
 {
-	DLLNode* tmp;
+	DoublyLinkedList_disableSkipIndex(dll);
+	DoublyLinkedList_disableHashIndex(dll);
+	DoublyLinkedList_disableRankIndex(dll);
+	// popHead already deallocates each node
 	while(dll->size > 0)
-	{
-		tmp = dll->head;
 		DoublyLinkedList_popHead(dll);
-		free(tmp);
-	}
 	free(dll);
 }
 /*
@@ -342,10 +1124,32 @@ int DoublyLinkedList_sortedInsert(DoublyLinkedList* dll, E value)
 	// Do this so the insert functions will work
 	dll->sorted = 0;
 	int returnVal = 1;
+	if(dll->skipIndex != NULL)
+	{
+		DLLSkipNode* update[DLL_SKIP_MAXLEVEL];
+		DLLSkipNode* x = DoublyLinkedList_skipSearch(dll, value, 0, update);
+		DLLNode* newNode;
+		if(x->forward[0] != NULL)
+		{
+			returnVal = DoublyLinkedList_insertBefore(x->forward[0]->node, value);
+			newNode = x->forward[0]->node->prev;
+		}
+		else
+		{
+			returnVal = DoublyLinkedList_insertAfter(dll->tail, value);
+			newNode = dll->tail;
+		}
+		dll->sorted = 1;
+		if(!returnVal && DoublyLinkedList_skipLink(dll->skipIndex, newNode, update))
+			DoublyLinkedList_disableSkipIndex(dll);
+		return returnVal;
+	}
 	DLL_DOUBLE_TRAVERSAL(dll, frontPtr, rearPtr)
 	{
+		CONTAINER_STATS_ADD(dll, nodesVisited, 2);
 		if(dll->compare)
 		{
+			CONTAINER_STATS_ADD(dll, compares, 2);
 			if(dll->compare(frontPtr->data, value) >= 0)
 			{
 				returnVal = DoublyLinkedList_insertBefore(frontPtr, value);
@@ -371,6 +1175,435 @@ int DoublyLinkedList_sortedInsert(DoublyLinkedList* dll, E value)
 			}
 		}
 	}
+	// on an even size, value can belong right between the two halves
+	if(returnVal && (size_t)_i == (dll->size+1)/2)
+		returnVal = DoublyLinkedList_insertBefore(frontPtr, value);
 	dll->sorted = 1;
 	return returnVal;
 }
+/*
+ * Builds a skip-list index over an auto-sorted (or empty) list.
+ * Nonzero on failure, or if the list is not sorted.
+ */
+int DoublyLinkedList_enableSkipIndex(DoublyLinkedList* dll)
+{
+	if(dll == NULL) return 1;
+	if(dll->skipIndex != NULL) return 0;
+	if(dll->size > 0 && !dll->sorted) return 1;
+	DLLSkipIndex* index = (DLLSkipIndex*)malloc(sizeof(DLLSkipIndex));
+	if(index == NULL) return 1;
+	index->header = DoublyLinkedList_skipNode(NULL, DLL_SKIP_MAXLEVEL);
+	if(index->header == NULL)
+	{
+		free(index);
+		return 1;
+	}
+	index->level = 1;
+	index->seed = 0x9E3779B97F4A7C15ULL ^ (unsigned long long)(size_t)dll;
+	dll->skipIndex = index;
+	// the list is already in order, so every tower goes after the last ones
+	DLLSkipNode* last[DLL_SKIP_MAXLEVEL];
+	int i;
+	for(i = 0; i < DLL_SKIP_MAXLEVEL; i++)
+		last[i] = index->header;
+	DLLNode* handle;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		if(DoublyLinkedList_skipLink(index, handle, last))
+		{
+			DoublyLinkedList_disableSkipIndex(dll);
+			return 1;
+		}
+		DLLSkipNode* x = last[0]->forward[0];
+		for(i = 0; i < x->level; i++)
+			last[i] = x;
+	}
+	return 0;
+}
+/*
+ * Drops the skip-list index of a list, if it has one.
+ */
+void DoublyLinkedList_disableSkipIndex(DoublyLinkedList* dll)
+{
+	if(dll == NULL || dll->skipIndex == NULL) return;
+	DoublyLinkedList_skipClear(dll->skipIndex);
+	free(dll->skipIndex->header);
+	free(dll->skipIndex);
+	dll->skipIndex = NULL;
+}
+/*
+ * Returns the first node of an auto-sorted list whose value is not less than
+ * value, or NULL if there is none.
+ */
+DLLNode* DoublyLinkedList_lowerBound(DoublyLinkedList* dll, E value)
+{
+	if(dll == NULL) return NULL;
+	if(dll->skipIndex != NULL && dll->sorted)
+	{
+		DLLSkipNode* x = DoublyLinkedList_skipSearch(dll, value, 0, NULL);
+		return x->forward[0] != NULL ? x->forward[0]->node : NULL;
+	}
+	DLLNode* handle;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		if(DoublyLinkedList_compareValues(dll, handle->data, value) >= 0)
+			return handle;
+	}
+	return NULL;
+}
+/*
+ * Returns the first node of an auto-sorted list whose value is greater than
+ * value, or NULL if there is none.
+ */
+DLLNode* DoublyLinkedList_upperBound(DoublyLinkedList* dll, E value)
+{
+	if(dll == NULL) return NULL;
+	if(dll->skipIndex != NULL && dll->sorted)
+	{
+		DLLSkipNode* x = DoublyLinkedList_skipSearch(dll, value, 1, NULL);
+		return x->forward[0] != NULL ? x->forward[0]->node : NULL;
+	}
+	DLLNode* handle;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		if(DoublyLinkedList_compareValues(dll, handle->data, value) > 0)
+			return handle;
+	}
+	return NULL;
+}
+/*
+ * Builds a hash index over a list, kept up to date by every push, pop,
+ * insert, remove and setData. If hash is NULL, DoublyLinkedList_hash() is
+ * used. Nonzero on failure.
+ */
+int DoublyLinkedList_enableHashIndex(DoublyLinkedList* dll, size_t (*hash)(E value))
+{
+	if(dll == NULL) return 1;
+	DoublyLinkedList_disableHashIndex(dll);
+	DLLHashIndex* index = (DLLHashIndex*)malloc(sizeof(DLLHashIndex));
+	if(index == NULL) return 1;
+	index->capacity = 16;
+	while(index->capacity < dll->size * 2)
+		index->capacity *= 2;
+	index->slots = (DLLHashSlot*)calloc(index->capacity, sizeof(DLLHashSlot));
+	if(index->slots == NULL)
+	{
+		free(index);
+		return 1;
+	}
+	index->count = 0;
+	index->hash = hash ? hash : DoublyLinkedList_hash;
+	DLLNode* handle;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		DoublyLinkedList_hashPlace(index, handle, index->hash(handle->data));
+	}
+	dll->hashIndex = index;
+	return 0;
+}
+/*
+ * Drops the hash index of a list, if it has one.
+ */
+void DoublyLinkedList_disableHashIndex(DoublyLinkedList* dll)
+{
+	if(dll == NULL || dll->hashIndex == NULL) return;
+	free(dll->hashIndex->slots);
+	free(dll->hashIndex);
+	dll->hashIndex = NULL;
+}
+/*
+ * Default hash for the hash index, which hashes the bytes of value (FNV-1a).
+ */
+size_t DoublyLinkedList_hash(E value)
+{
+	// +0 and -0 are equal, so they have to hash the same
+	if(value == 0) value = 0;
+	size_t bytes = sizeof(E);
+#if LDBL_MANT_DIG == 64
+	// x87 long doubles only use 10 of their bytes, the rest is padding
+	if(bytes == sizeof(long double) && bytes > 10) bytes = 10;
+#endif
+	const unsigned char* p = (const unsigned char*)&value;
+	unsigned long long hash = 14695981039346656037ULL;
+	size_t i;
+	for(i = 0; i < bytes; i++)
+	{
+		hash ^= p[i];
+		hash *= 1099511628211ULL;
+	}
+	return (size_t)(hash ^ (hash >> 32));
+}
+/*
+ * Sorts the list in ascending order in O(n log n) by relinking its nodes,
+ * then turns automatic sorting on. Nonzero on failure.
+ */
+int DoublyLinkedList_sort(DoublyLinkedList* dll)
+{
+	if(dll == NULL) return 1;
+	if(dll->size > 1)
+		DoublyLinkedList_relink(dll, DoublyLinkedList_sortChain(dll, dll->head));
+	dll->sorted = 1;
+	// the towers have to follow the new order
+	if(dll->skipIndex != NULL)
+	{
+		DoublyLinkedList_disableSkipIndex(dll);
+		DoublyLinkedList_enableSkipIndex(dll);
+	}
+	DoublyLinkedList_rankRebuild(dll);
+	return 0;
+}
+/*
+ * Moves every node of the sorted list src into the sorted list dst in a
+ * single pass, keeping dst in ascending order and leaving src empty.
+ * Each node of src is spliced in right after the nodes of dst that aren't
+ * greater than it, so the walk stops as soon as src runs out. If dst has a
+ * skip index and src is small next to it, every node is placed through the
+ * index instead of walking dst at all.
+ * Nonzero on failure.
+ */
+int DoublyLinkedList_merge(DoublyLinkedList* dst, DoublyLinkedList* src)
+{
+	if(dst == NULL || src == NULL || dst == src) return 1;
+	if(dst->pool != src->pool) return 1;
+	if((dst->size > 1 && !dst->sorted) || (src->size > 1 && !src->sorted))
+		return 1;
+	dst->sorted = 1;
+	if(src->size == 0) return 0;
+	if(src->skipIndex != NULL) DoublyLinkedList_skipClear(src->skipIndex);
+	if(src->rankIndex != NULL) DoublyLinkedList_rankClear(src->rankIndex);
+	if(src->hashIndex != NULL)
+	{
+		memset(src->hashIndex->slots, 0,
+				src->hashIndex->capacity * sizeof(DLLHashSlot));
+		src->hashIndex->count = 0;
+	}
+	int useSkip = dst->skipIndex != NULL && src->size < dst->size / 8;
+	DLLNode* at = dst->head;
+	DLLNode* node = src->head;
+	while(node != NULL)
+	{
+		DLLNode* next = node->next;
+		if(useSkip && dst->skipIndex != NULL)
+		{
+			DLLSkipNode* update[DLL_SKIP_MAXLEVEL];
+			DLLSkipNode* x = DoublyLinkedList_skipSearch(dst, node->data, 1, update);
+			at = x->forward[0] != NULL ? x->forward[0]->node : NULL;
+			DoublyLinkedList_linkBefore(dst, node, at);
+			if(DoublyLinkedList_skipLink(dst->skipIndex, node, update))
+				DoublyLinkedList_disableSkipIndex(dst);
+		}
+		else
+		{
+			while(at != NULL && DoublyLinkedList_compareValues(dst, at->data, node->data) <= 0)
+				at = at->next;
+			DoublyLinkedList_linkBefore(dst, node, at);
+		}
+		DoublyLinkedList_hashInsert(dst, node);
+		node = next;
+	}
+	src->head = NULL;
+	src->tail = NULL;
+	src->size = 0;
+	if(!useSkip && dst->skipIndex != NULL)
+	{
+		DoublyLinkedList_disableSkipIndex(dst);
+		DoublyLinkedList_enableSkipIndex(dst);
+	}
+	// the rank of nearly every node of dst may have changed
+	DoublyLinkedList_rankRebuild(dst);
+	return 0;
+}
+/*
+ * Inserts count values at once such that the list remains in ascending
+ * order. Nonzero on failure, in which case the list is left as it was.
+ */
+int DoublyLinkedList_sortedInsertArray(DoublyLinkedList* dll, const E* values, size_t count)
+{
+	if(dll == NULL || (values == NULL && count > 0)) return 1;
+	if(dll->size == 0) dll->sorted = 1;
+	assert(dll->sorted);
+	if(count == 0) return 0;
+	if(dll->pool != NULL && DLLNodePool_reserve(dll->pool, count)) return 1;
+	// chain the new nodes up through next only, then sort them on their own
+	DLLNode* chain = NULL;
+	size_t i;
+	for(i = count; i > 0; i--)
+	{
+		DLLNode* node = DoublyLinkedList_allocNode(dll);
+		if(node == NULL)
+		{
+			while(chain != NULL)
+			{
+				node = chain->next;
+				DoublyLinkedList_freeNode(dll, chain);
+				chain = node;
+			}
+			return 1;
+		}
+		node->data = values[i-1];
+		node->next = chain;
+		chain = node;
+	}
+	DoublyLinkedList batch = *dll;
+	batch.head = DoublyLinkedList_sortChain(dll, chain);
+	batch.size = count;
+	batch.skipIndex = NULL;
+	batch.hashIndex = NULL;
+	batch.rankIndex = NULL;
+	return DoublyLinkedList_merge(dll, &batch);
+}
+/*
+ * Builds a rank index over a list in O(n). Nonzero on failure.
+ */
+int DoublyLinkedList_enableRankIndex(DoublyLinkedList* dll)
+{
+	if(dll == NULL) return 1;
+	if(dll->rankIndex != NULL) return 0;
+	DLLRankIndex* index = (DLLRankIndex*)malloc(sizeof(DLLRankIndex));
+	if(index == NULL) return 1;
+	index->root = NULL;
+	index->seed = 0xD1B54A32D192ED03ULL ^ (unsigned long long)(size_t)dll;
+	dll->rankIndex = index;
+	// The nodes come in order, so each one goes on the right spine of the
+	// tree, above every spine node of lower priority. Nodes passed over
+	// never change again, so that's when they get counted.
+	DLLRankNode* last = NULL;
+	DLLNode* handle;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		DLLRankNode* x = (DLLRankNode*)malloc(sizeof(DLLRankNode));
+		if(x == NULL)
+		{
+			DoublyLinkedList_disableRankIndex(dll);
+			return 1;
+		}
+		x->node = handle;
+		x->priority = DoublyLinkedList_rankPriority(index);
+		x->right = NULL;
+		handle->rank = x;
+		DLLRankNode* below = NULL;
+		while(last != NULL && last->priority < x->priority)
+		{
+			DoublyLinkedList_rankRecount(last);
+			below = last;
+			last = last->parent;
+		}
+		x->left = below;
+		if(below != NULL) below->parent = x;
+		x->parent = last;
+		if(last != NULL) last->right = x;
+		else index->root = x;
+		last = x;
+	}
+	for(; last != NULL; last = last->parent)
+		DoublyLinkedList_rankRecount(last);
+	return 0;
+}
+/*
+ * Drops the rank index of a list, if it has one.
+ */
+void DoublyLinkedList_disableRankIndex(DoublyLinkedList* dll)
+{
+	if(dll == NULL || dll->rankIndex == NULL) return;
+	DoublyLinkedList_rankClear(dll->rankIndex);
+	free(dll->rankIndex);
+	dll->rankIndex = NULL;
+}
+/*
+ * Returns the node at position index (0 being the head), or NULL if index
+ * is out of range.
+ */
+DLLNode* DoublyLinkedList_getAt(DoublyLinkedList* dll, size_t index)
+{
+	if(dll == NULL || index >= dll->size) return NULL;
+	DLLNode* handle;
+	if(dll->rankIndex != NULL)
+	{
+		DLLRankNode* x = dll->rankIndex->root;
+		for(;;)
+		{
+			CONTAINER_STATS_ADD(dll, nodesVisited, 1);
+			size_t left = DoublyLinkedList_rankCount(x->left);
+			if(index == left) return x->node;
+			if(index < left) x = x->left;
+			else
+			{
+				index -= left + 1;
+				x = x->right;
+			}
+		}
+	}
+	// without an index, walk in from whichever end is closer
+	if(index < dll->size / 2)
+	{
+		CONTAINER_STATS_ADD(dll, nodesVisited, index);
+		for(handle = dll->head; index > 0; index--)
+			handle = handle->next;
+	}
+	else
+	{
+		index = dll->size - 1 - index;
+		CONTAINER_STATS_ADD(dll, nodesVisited, index);
+		for(handle = dll->tail; index > 0; index--)
+			handle = handle->prev;
+	}
+	return handle;
+}
+/*
+ * Creates a new node from data and inserts it at position index, index
+ * being at most the size of the list. Nonzero on failure.
+ */
+int DoublyLinkedList_insertAt(DoublyLinkedList* dll, size_t index, E data)
+{
+	if(dll == NULL || index > dll->size) return 1;
+	assert(!dll->sorted);
+	if(index == dll->size) return DoublyLinkedList_pushTail(dll, data);
+	return DoublyLinkedList_insertBefore(DoublyLinkedList_getAt(dll, index), data);
+}
+/*
+ * Removes the node at position index and deallocates it. Nonzero if index
+ * is out of range.
+ */
+int DoublyLinkedList_removeAt(DoublyLinkedList* dll, size_t index)
+{
+	DLLNode* node = DoublyLinkedList_getAt(dll, index);
+	if(node == NULL) return 1;
+	return DoublyLinkedList_remove(node);
+}
+/*
+ * Returns the position of node in its list, 0 being the head.
+ */
+size_t DoublyLinkedList_rankOf(DLLNode* node)
+{
+	assert(node != NULL);
+	size_t rank = 0;
+	if(node->list->rankIndex != NULL)
+	{
+		DLLRankNode* x = node->rank;
+		rank = DoublyLinkedList_rankCount(x->left);
+		for(; x->parent != NULL; x = x->parent)
+			if(x == x->parent->right)
+				rank += DoublyLinkedList_rankCount(x->parent->left) + 1;
+		return rank;
+	}
+	for(node = node->prev; node != NULL; node = node->prev)
+		rank++;
+	return rank;
+}
+/*
+ * Copies the counters of dll into stats. Nonzero if they're compiled out.
+ */
+int DoublyLinkedList_getStats(DoublyLinkedList* dll, ContainerStats* stats)
+{
+	if(dll == NULL || stats == NULL) return 1;
+	return CONTAINER_STATS_GET(dll, stats);
+}
+/*
+ * Zeroes the counters of dll
+ */
+void DoublyLinkedList_resetStats(DoublyLinkedList* dll)
+{
+	if(dll == NULL) return;
+	CONTAINER_STATS_RESET(dll);
+	CONTAINER_STATS_PEAK(dll, dll->size);
+}
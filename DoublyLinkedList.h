@@ -4,6 +4,11 @@
  *  Created on: Feb 24, 2009
  *      Author: Yama H
  */
+#ifndef DOUBLYLINKEDLIST_H
+#define DOUBLYLINKEDLIST_H
+
+#include <stddef.h>
+#include "ContainerStats.h"
 
 /*
  * Traverses the list from head to tail
@@ -53,18 +58,24 @@
  * or pointer that could be cast into it.
  * To redefine the generics, just call #define GENERICS [type] before
  * importing DoublyLinkedList.h
+ * (GENERICS_TYPEDEF keeps E from being typedef'd twice when several of these
+ * headers are imported together)
  */
 #ifndef GENERICS
 #define GENERICS long double
 #endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
 typedef GENERICS E;
+#endif
 
 /*
  * A DLLNode (DoublyLinkedListNode) consists of a piece of data of type E
  * (which is really usually some other type cast into an E, which can also be a
  * pointer) and pointers to the next and previous DLLNodes in the list (NULL
  * if the node is a head or tail node). There is also a pointer to the list
- * in which this node is contained.
+ * in which this node is contained, and one to the node's place in the rank
+ * index, which is only meaningful while the list has one.
  */
 struct DLLNode;
 struct DoublyLinkedList;
@@ -74,8 +85,44 @@ typedef struct DLLNode
 	struct DLLNode* next;
 	struct DLLNode* prev;
 	struct DoublyLinkedList* list;
+	struct DLLRankNode* rank;
 }DLLNode;
 
+/*
+ * A DLLNodePool hands out DLLNodes from large slabs instead of calling
+ * malloc() once per node. Nodes given back to the pool are recycled through
+ * a free list, and DLLNodePool_free() releases every slab at once. A pool
+ * can be shared by any number of lists.
+ */
+#define DLLNODEPOOL_DEFAULT_SLAB 256	// nodes per slab if none is given
+typedef struct DLLNodePool
+{
+	DLLNode* freeList;
+	DLLNode* slabs;
+	size_t slabSize;
+	size_t available;	// nodes on the free list
+}DLLNodePool;
+
+/*
+ * A DLLSkipIndex is an optional skip list kept over the nodes of an
+ * auto-sorted list, so that sortedInsert, find and the bound lookups don't
+ * have to walk the list. It is private to DoublyLinkedList.c.
+ */
+struct DLLSkipIndex;
+/*
+ * A DLLHashIndex is an optional hash table from values to the DLLNodes
+ * holding them, so that find doesn't have to walk the list. It is private to
+ * DoublyLinkedList.c.
+ */
+struct DLLHashIndex;
+/*
+ * A DLLRankIndex is an optional balanced tree over the node order, counting
+ * the nodes under every branch, so that nodes can be found by position and
+ * positions by node without walking the list. It is private to
+ * DoublyLinkedList.c.
+ */
+struct DLLRankIndex;
+
 /*
  * A DoublyLinkedList consists of a pointer to the head node, a pointer to
  * the tail node, a size_t representing the number of elements currently in
@@ -98,8 +145,39 @@ typedef struct DoublyLinkedList
 	size_t size;
 	short int sorted;
 	int (*compare)(E val1, E val2);
+	DLLNodePool* pool;
+	struct DLLSkipIndex* skipIndex;
+	struct DLLHashIndex* hashIndex;
+	struct DLLRankIndex* rankIndex;
+	CONTAINER_STATS_MEMBER		// only with -DCONTAINER_STATS, see ContainerStats.h
 }DoublyLinkedList;
 
+/*
+ * Allocates an empty DLLNodePool that grabs nodesPerSlab nodes at a time
+ * (DLLNODEPOOL_DEFAULT_SLAB if nodesPerSlab is 0). Returns NULL on failure.
+ */
+DLLNodePool* DLLNodePool_create(size_t nodesPerSlab);
+/*
+ * Hands out a node from the pool, allocating a new slab if the free list is
+ * empty. Returns NULL on failure.
+ */
+DLLNode* DLLNodePool_alloc(DLLNodePool* pool);
+/*
+ * Makes sure at least count nodes can be handed out without allocating,
+ * grabbing them all in a single slab if need be. Nonzero on failure.
+ */
+int DLLNodePool_reserve(DLLNodePool* pool, size_t count);
+/*
+ * Gives a node back to the pool so it can be handed out again.
+ */
+void DLLNodePool_release(DLLNodePool* pool, DLLNode* node);
+/*
+ * Releases every slab of the pool at once, along with the pool itself.
+ * (note: any list still using the pool is left with dangling nodes, so
+ * either free those lists first or simply drop them along with the pool)
+ */
+void DLLNodePool_free(DLLNodePool* pool);
+
 /*
  * Initializes a pre-allocated List and creates first node.
  */
@@ -108,6 +186,11 @@ void DoublyLinkedList_initialize(DoublyLinkedList* dll, E data, short int autoSo
  * Allocates an empty DoublyLinkedList
  */
 DoublyLinkedList* DoublyLinkedList_create();
+/*
+ * Allocates an empty DoublyLinkedList whose nodes come from pool instead of
+ * malloc(). The pool is not owned by the list and may be shared.
+ */
+DoublyLinkedList* DoublyLinkedList_createWithPool(DLLNodePool* pool);
 /*
  * Adds an entry to the tail end of the List.
  */
@@ -151,9 +234,98 @@ DLLNode DoublyLinkedList_getPrev(DLLNode node);
  * Retrieves the data from the node passed.
  */
 E DoublyLinkedList_getData(DLLNode node);
+
+/*
+ * Iterators are plain node pointers, so walking a list with them costs one
+ * pointer chase per step instead of a copy of the node, and the data can be
+ * changed in place through DoublyLinkedList_ref.
+ * Usage:
+ * DLLIterator it;
+ * for(it = DoublyLinkedList_begin(list); it != DoublyLinkedList_end(list);
+ *         it = DoublyLinkedList_next(it))
+ *      [DoublyLinkedList_deref(it) is the current element]
+ */
+typedef DLLNode* DLLIterator;
+typedef const DLLNode* DLLConstIterator;
+/*
+ * Returns an iterator at the head, or the end iterator if dll is empty.
+ */
+static inline DLLIterator DoublyLinkedList_begin(DoublyLinkedList* dll)
+{
+	return dll->head;
+}
+/*
+ * Returns an iterator at the tail, for walking backwards to the end
+ * iterator.
+ */
+static inline DLLIterator DoublyLinkedList_rbegin(DoublyLinkedList* dll)
+{
+	return dll->tail;
+}
+/*
+ * Returns the iterator one past either end of dll.
+ */
+static inline DLLIterator DoublyLinkedList_end(DoublyLinkedList* dll)
+{
+	(void)dll;
+	return NULL;
+}
+/*
+ * Returns an iterator at the node after it.
+ */
+static inline DLLIterator DoublyLinkedList_next(DLLIterator it)
+{
+	return it->next;
+}
+/*
+ * Returns an iterator at the node before it.
+ */
+static inline DLLIterator DoublyLinkedList_prev(DLLIterator it)
+{
+	return it->prev;
+}
+/*
+ * Returns a pointer to the data at it, to read or change in place.
+ * (note: changing it bypasses the hash index and sorting; use
+ * DoublyLinkedList_setData for lists that have either)
+ */
+static inline E* DoublyLinkedList_ref(DLLIterator it)
+{
+	return &it->data;
+}
+/*
+ * Read-only versions of the above, for const lists.
+ */
+static inline DLLConstIterator DoublyLinkedList_cbegin(const DoublyLinkedList* dll)
+{
+	return dll->head;
+}
+static inline DLLConstIterator DoublyLinkedList_crbegin(const DoublyLinkedList* dll)
+{
+	return dll->tail;
+}
+static inline DLLConstIterator DoublyLinkedList_cnext(DLLConstIterator it)
+{
+	return it->next;
+}
+static inline DLLConstIterator DoublyLinkedList_cprev(DLLConstIterator it)
+{
+	return it->prev;
+}
+/*
+ * Returns the data at it, which can be either kind of iterator.
+ */
+static inline E DoublyLinkedList_deref(DLLConstIterator it)
+{
+	return it->data;
+}
+
 /*
  * Sets the data in a specified node in the list to a specified value, and
- * updates the node passed in. Nonzero on failure.
+ * updates the node passed in (and the hash and skip-list indexes, if there
+ * are any). Zero if node is null.
+ * note: on an auto-sorted list the node stays where it is, so a new value
+ * that's out of order breaks the sorting just as writing it directly would
  */
 int DoublyLinkedList_setData(DLLNode* node, E data);
 /*
@@ -166,6 +338,20 @@ int DoublyLinkedList_insertAfter(DLLNode* handle, E data);
  * Nonzero on failure.
  */
 int DoublyLinkedList_insertBefore(DLLNode* handle, E data);
+/*
+ * Moves node to the head of its list by relinking it, so the node (and any
+ * pointer to it) stays the same and nothing is allocated or freed. This is
+ * the move-to-front of an LRU list. O(1), or O(log n) with a rank index,
+ * whose tree node for it has to be moved too. Nonzero on failure.
+ * note: this method is disabled when autoSort is enabled
+ */
+int DoublyLinkedList_moveToHead(DLLNode* node);
+/*
+ * Moves node to the tail of its list by relinking it, in O(1), or O(log n)
+ * with a rank index. Nonzero on failure.
+ * note: this method is disabled when autoSort is enabled
+ */
+int DoublyLinkedList_moveToTail(DLLNode* node);
 /*
  * Returns the number of size currently in the list.
  */
@@ -177,7 +363,8 @@ size_t DoublyLinkedList_getSize(DoublyLinkedList* dll);
  */
 DLLNode* DoublyLinkedList_find(DoublyLinkedList* dll, E value);
 /*
- * Empties and deallocates a DoublyLinkedList
+ * Empties and deallocates a DoublyLinkedList. If the list uses a pool, its
+ * nodes are given back to the pool, which stays alive.
  */
 void DoublyLinkedList_free(DoublyLinkedList* dll);
 /*
@@ -187,3 +374,119 @@ void DoublyLinkedList_free(DoublyLinkedList* dll);
  * note: this function uses DoublyLinkedList.compare iff it's been implemented
  */
 int DoublyLinkedList_sortedInsert(DoublyLinkedList* dll, E value);
+/*
+ * Builds a skip-list index over an auto-sorted (or empty) list. From then on
+ * sortedInsert, find, lowerBound and upperBound take O(log n) compares,
+ * while DLL_TRAVERSAL keeps walking the plain node order.
+ * Nonzero on failure, or if the list is not sorted.
+ */
+int DoublyLinkedList_enableSkipIndex(DoublyLinkedList* dll);
+/*
+ * Drops the skip-list index of a list, if it has one.
+ */
+void DoublyLinkedList_disableSkipIndex(DoublyLinkedList* dll);
+/*
+ * Returns the first node of an auto-sorted list whose value is not less than
+ * value, or NULL if there is none.
+ * note: this function uses DoublyLinkedList.compare iff it's been implemented
+ */
+DLLNode* DoublyLinkedList_lowerBound(DoublyLinkedList* dll, E value);
+/*
+ * Returns the first node of an auto-sorted list whose value is greater than
+ * value, or NULL if there is none.
+ * note: this function uses DoublyLinkedList.compare iff it's been implemented
+ */
+DLLNode* DoublyLinkedList_upperBound(DoublyLinkedList* dll, E value);
+/*
+ * Builds a hash index over a list, kept up to date by every push, pop,
+ * insert, remove and setData, so that find takes O(1) on average whether or
+ * not the list is sorted. hash must agree with the way values are compared
+ * (DoublyLinkedList.compare iff it's been implemented, '==' otherwise); if
+ * it's NULL, DoublyLinkedList_hash() is used, which is only right for the
+ * '==' case.
+ * Nonzero on failure.
+ */
+int DoublyLinkedList_enableHashIndex(DoublyLinkedList* dll, size_t (*hash)(E value));
+/*
+ * Drops the hash index of a list, if it has one.
+ */
+void DoublyLinkedList_disableHashIndex(DoublyLinkedList* dll);
+/*
+ * Default hash for the hash index, which hashes the bytes of value. Fine for
+ * numbers and for pointers compared by address; pointers to structs compared
+ * with DoublyLinkedList.compare need a hash of their own.
+ */
+size_t DoublyLinkedList_hash(E value);
+/*
+ * Sorts the list in ascending order in O(n log n) by relinking its nodes
+ * (a stable, bottom-up merge sort that allocates nothing), then turns
+ * automatic sorting on. Nonzero on failure.
+ * note: this function uses DoublyLinkedList.compare iff it's been implemented
+ */
+int DoublyLinkedList_sort(DoublyLinkedList* dll);
+/*
+ * Moves every node of the sorted list src into the sorted list dst in a
+ * single pass, keeping dst in ascending order and leaving src empty. Both
+ * lists have to use the same pool (or none). Nonzero on failure.
+ * note: this function uses dst's compare iff it's been implemented
+ */
+int DoublyLinkedList_merge(DoublyLinkedList* dst, DoublyLinkedList* src);
+/*
+ * Inserts count values at once such that the list remains in ascending
+ * order: the values are sorted among themselves and then merged into the
+ * list in a single pass, for O(n + count log count) instead of the
+ * O(n * count) of calling sortedInsert for each of them. If the list uses a
+ * pool, all the new nodes are reserved from it up front.
+ * Only works on auto-sorted or empty lists, just like sortedInsert.
+ * Nonzero on failure, in which case the list is left as it was.
+ * note: this function uses DoublyLinkedList.compare iff it's been implemented
+ */
+int DoublyLinkedList_sortedInsertArray(DoublyLinkedList* dll, const E* values, size_t count);
+/*
+ * Builds a rank index over a list in O(n), kept up to date by every push,
+ * pop, insert and remove, and rebuilt after sort and merge. From then on
+ * getAt, insertAt, removeAt and rankOf take O(log n), while pushes,
+ * pops, insertAfter/insertBefore, remove and moveToHead/moveToTail go from
+ * O(1) to O(log n). Works on sorted and unsorted lists alike.
+ * Nonzero on failure.
+ */
+int DoublyLinkedList_enableRankIndex(DoublyLinkedList* dll);
+/*
+ * Drops the rank index of a list, if it has one.
+ */
+void DoublyLinkedList_disableRankIndex(DoublyLinkedList* dll);
+/*
+ * Returns the node at position index (0 being the head), or NULL if index
+ * is out of range. O(log n) with a rank index, otherwise the list is walked
+ * from whichever end is closer.
+ */
+DLLNode* DoublyLinkedList_getAt(DoublyLinkedList* dll, size_t index);
+/*
+ * Creates a new node from data and inserts it at position index, so that
+ * getAt(dll, index) returns it afterwards. index can be anything from 0 to
+ * the size of the list. Nonzero on failure.
+ * note: this method is disabled when autoSort is enabled
+ */
+int DoublyLinkedList_insertAt(DoublyLinkedList* dll, size_t index, E data);
+/*
+ * Removes the node at position index and deallocates it. Nonzero if index
+ * is out of range.
+ */
+int DoublyLinkedList_removeAt(DoublyLinkedList* dll, size_t index);
+/*
+ * Returns the position of node in its list, 0 being the head. O(log n)
+ * with a rank index, O(n) without.
+ */
+size_t DoublyLinkedList_rankOf(DLLNode* node);
+/*
+ * Copies what dll has counted since it was created or last reset into
+ * stats. Nonzero if dll or stats is NULL, or (with stats zeroed) if the
+ * program wasn't compiled with CONTAINER_STATS.
+ */
+int DoublyLinkedList_getStats(DoublyLinkedList* dll, ContainerStats* stats);
+/*
+ * Zeroes the counters of dll, with peakSize starting over from its size.
+ */
+void DoublyLinkedList_resetStats(DoublyLinkedList* dll);
+
+#endif
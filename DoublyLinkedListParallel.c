@@ -0,0 +1,357 @@
+/*
+ * DoublyLinkedListParallel - Multi-threaded whole-list operations on a
+ * DoublyLinkedList, built on POSIX threads.
+ */
+#include <stdlib.h>
+#include <pthread.h>
+#include "DoublyLinkedList.h"
+#include "DoublyLinkedListParallel.h"
+
+/*
+ * Sublists shorter than this aren't worth a thread of their own.
+ */
+#define DLL_PARALLEL_MIN_SEGMENT 4096
+
+/*
+ * A DLLSortJob sorts dst, merges src into dst, or (if owner is set) points
+ * every node of dst back at owner.
+ */
+typedef struct
+{
+	DoublyLinkedList* dst;
+	DoublyLinkedList* src;
+	DoublyLinkedList* owner;
+	int result;
+}DLLSortJob;
+
+/*
+ * Thread entry point that carries out one DLLSortJob.
+ */
+static void* DoublyLinkedList_sortWorker(void* arg)
+{
+	DLLSortJob* job = (DLLSortJob*)arg;
+	if(job->owner != NULL)
+	{
+		DLLNode* node;
+		DLL_TRAVERSAL(job->dst, node)
+		{
+			node->list = job->owner;
+		}
+		job->result = 0;
+	}
+	else if(job->src == NULL)
+		job->result = DoublyLinkedList_sort(job->dst);
+	else
+		job->result = DoublyLinkedList_merge(job->dst, job->src);
+	return NULL;
+}
+/*
+ * Carries out count jobs, the first on the calling thread and the rest on
+ * threads of their own (or on the calling thread too, if a thread can't be
+ * started). Nonzero if any of them failed.
+ */
+static int DoublyLinkedList_runSortJobs(DLLSortJob* jobs, int count)
+{
+	pthread_t* ids = (pthread_t*)malloc(count * sizeof(pthread_t));
+	char* started = (char*)calloc(count, sizeof(char));
+	int i, result = 0;
+	for(i = 1; i < count; i++)
+	{
+		if(ids != NULL && started != NULL &&
+				!pthread_create(&ids[i], NULL, DoublyLinkedList_sortWorker, &jobs[i]))
+			started[i] = 1;
+		else
+			DoublyLinkedList_sortWorker(&jobs[i]);
+	}
+	DoublyLinkedList_sortWorker(&jobs[0]);
+	for(i = 0; i < count; i++)
+	{
+		if(started != NULL && started[i]) pthread_join(ids[i], NULL);
+		result |= jobs[i].result;
+	}
+	free(ids);
+	free(started);
+	return result;
+}
+/*
+ * Sorts the list on up to threads threads. Nonzero on failure.
+ */
+int DoublyLinkedList_parallelSort(DoublyLinkedList* dll, int threads)
+{
+	if(dll == NULL) return 1;
+	if((size_t)threads > dll->size / DLL_PARALLEL_MIN_SEGMENT)
+		threads = (int)(dll->size / DLL_PARALLEL_MIN_SEGMENT);
+	if(threads < 2) return DoublyLinkedList_sort(dll);
+	DoublyLinkedList* views = (DoublyLinkedList*)malloc(threads * sizeof(DoublyLinkedList));
+	DLLSortJob* jobs = (DLLSortJob*)malloc(threads * sizeof(DLLSortJob));
+	if(views == NULL || jobs == NULL)
+	{
+		free(views);
+		free(jobs);
+		return DoublyLinkedList_sort(dll);
+	}
+	// The sublists can't touch the indexes, which get rebuilt at the end.
+	struct DLLSkipIndex* skipIndex = dll->skipIndex;
+	struct DLLHashIndex* hashIndex = dll->hashIndex;
+	struct DLLRankIndex* rankIndex = dll->rankIndex;
+	dll->skipIndex = NULL;
+	dll->hashIndex = NULL;
+	dll->rankIndex = NULL;
+	// cut the list into threads sublists of (nearly) equal size
+	DLLNode* node = dll->head;
+	size_t remaining = dll->size;
+	int i;
+	for(i = 0; i < threads; i++)
+	{
+		size_t count = remaining / (threads - i), j;
+		views[i] = *dll;
+		views[i].head = node;
+		views[i].size = count;
+		views[i].sorted = 0;
+		for(j = 1; j < count; j++)
+			node = node->next;
+		views[i].tail = node;
+		node = node->next;
+		views[i].tail->next = NULL;
+		if(node != NULL) node->prev = NULL;
+		remaining -= count;
+		jobs[i].dst = &views[i];
+		jobs[i].src = NULL;
+		jobs[i].owner = NULL;
+	}
+	int result = DoublyLinkedList_runSortJobs(jobs, threads);
+	// merge neighbouring sublists pairwise until two are left
+	int n = threads;
+	while(n > 2)
+	{
+		int pairs = n / 2;
+		for(i = 0; i < pairs; i++)
+		{
+			jobs[i].dst = &views[2*i];
+			jobs[i].src = &views[2*i+1];
+		}
+		result |= DoublyLinkedList_runSortJobs(jobs, pairs);
+		for(i = 0; i < pairs; i++)
+			views[i] = views[2*i];
+		if(n & 1) views[pairs] = views[n-1];
+		n = pairs + (n & 1);
+	}
+	// every node still points at one of the sublists
+	for(i = 0; i < 2; i++)
+	{
+		jobs[i].dst = &views[i];
+		jobs[i].owner = dll;
+	}
+	result |= DoublyLinkedList_runSortJobs(jobs, 2);
+	// the last merge goes into dll itself
+	dll->head = views[0].head;
+	dll->tail = views[0].tail;
+	dll->size = views[0].size;
+	dll->sorted = 1;
+	result |= DoublyLinkedList_merge(dll, &views[1]);
+	free(views);
+	free(jobs);
+	dll->hashIndex = hashIndex;
+	dll->skipIndex = skipIndex;
+	if(skipIndex != NULL)
+	{
+		DoublyLinkedList_disableSkipIndex(dll);
+		DoublyLinkedList_enableSkipIndex(dll);
+	}
+	dll->rankIndex = rankIndex;
+	if(rankIndex != NULL)
+	{
+		DoublyLinkedList_disableRankIndex(dll);
+		DoublyLinkedList_enableRankIndex(dll);
+	}
+	return result;
+}
+/*
+ * A DLLSegment is one run of consecutive nodes, and what came out of
+ * reducing it.
+ */
+typedef struct
+{
+	DLLNode* start;
+	size_t count;
+	E result;
+}DLLSegment;
+/*
+ * What every segment task of a parallel pass needs: its segments, the
+ * function to apply and its context.
+ */
+typedef struct
+{
+	DLLSegment* segments;
+	void (*forEach)(DLLNode* node, void* context);
+	E (*map)(E value, void* context);
+	E (*combine)(E accumulator, E value, void* context);
+	E identity;
+	void* context;
+}DLLParallelPass;
+
+/*
+ * Returns the position at which segment k of count starts on a list of
+ * size nodes.
+ */
+static size_t DoublyLinkedList_segmentStart(size_t size, size_t k, size_t count)
+{
+	return (size_t)((unsigned long long)k * size / count);
+}
+/*
+ * Cuts a non-empty list into count segments of (nearly) equal size.
+ * Without a rank index, the front half of the cuts is found walking from
+ * the head and the back half walking from the tail, a step of each at a
+ * time, so the two pointer chases overlap.
+ */
+static void DoublyLinkedList_segment(DoublyLinkedList* dll, DLLSegment* segments, size_t count)
+{
+	size_t size = dll->size, k;
+	for(k = 0; k < count; k++)
+		segments[k].count = DoublyLinkedList_segmentStart(size, k + 1, count) -
+				DoublyLinkedList_segmentStart(size, k, count);
+	if(dll->rankIndex != NULL)
+	{
+		for(k = 0; k < count; k++)
+			segments[k].start = DoublyLinkedList_getAt(dll,
+					DoublyLinkedList_segmentStart(size, k, count));
+		return;
+	}
+	size_t mid = count / 2, front = 0, rear = count;
+	size_t frontIndex = 0, rearIndex = size - 1;
+	DLLNode* frontPtr = dll->head, *rearPtr = dll->tail;
+	while(front < mid || rear > mid)
+	{
+		if(front < mid)
+		{
+			if(frontIndex == DoublyLinkedList_segmentStart(size, front, count))
+				segments[front++].start = frontPtr;
+			else
+			{
+				frontPtr = frontPtr->next;
+				frontIndex++;
+			}
+		}
+		if(rear > mid)
+		{
+			if(rearIndex == DoublyLinkedList_segmentStart(size, rear - 1, count))
+				segments[--rear].start = rearPtr;
+			else
+			{
+				rearPtr = rearPtr->prev;
+				rearIndex--;
+			}
+		}
+	}
+}
+/*
+ * Task that runs the pass on one segment.
+ */
+static void DoublyLinkedList_segmentTask(void* arg, int index)
+{
+	DLLParallelPass* pass = (DLLParallelPass*)arg;
+	DLLSegment* segment = &pass->segments[index];
+	DLLNode* node = segment->start;
+	size_t i;
+	if(pass->forEach != NULL)
+	{
+		for(i = 0; i < segment->count; i++, node = node->next)
+			pass->forEach(node, pass->context);
+	}
+	else if(pass->map != NULL)
+	{
+		for(i = 0; i < segment->count; i++, node = node->next)
+			node->data = pass->map(node->data, pass->context);
+	}
+	else
+	{
+		E accumulator = pass->identity;
+		for(i = 0; i < segment->count; i++, node = node->next)
+			accumulator = pass->combine(accumulator, node->data, pass->context);
+		segment->result = accumulator;
+	}
+}
+/*
+ * Segments the list and runs pass over every segment, on pool if there is
+ * one. Nonzero on failure.
+ */
+static int DoublyLinkedList_runPass(DoublyLinkedList* dll, ThreadPool* pool,
+		DLLParallelPass* pass, size_t* count)
+{
+	*count = dll->size < DLL_PARALLEL_SEGMENTS ? dll->size : DLL_PARALLEL_SEGMENTS;
+	pass->segments = NULL;
+	if(*count == 0) return 0;
+	pass->segments = (DLLSegment*)malloc(*count * sizeof(DLLSegment));
+	if(pass->segments == NULL) return 1;
+	DoublyLinkedList_segment(dll, pass->segments, *count);
+	if(pool != NULL)
+		ThreadPool_run(pool, DoublyLinkedList_segmentTask, pass, (int)*count);
+	else
+	{
+		size_t k;
+		for(k = 0; k < *count; k++)
+			DoublyLinkedList_segmentTask(pass, (int)k);
+	}
+	return 0;
+}
+/*
+ * Calls fn on every node of the list, on the threads of pool.
+ * Nonzero on failure.
+ */
+int DoublyLinkedList_parallelForEach(DoublyLinkedList* dll, ThreadPool* pool,
+		void (*fn)(DLLNode* node, void* context), void* context)
+{
+	if(dll == NULL || fn == NULL) return 1;
+	DLLParallelPass pass;
+	size_t count;
+	pass.forEach = fn;
+	pass.map = NULL;
+	pass.combine = NULL;
+	pass.context = context;
+	int result = DoublyLinkedList_runPass(dll, pool, &pass, &count);
+	free(pass.segments);
+	return result;
+}
+/*
+ * Replaces every element of the list with fn(element), on the threads of
+ * pool. Nonzero on failure.
+ */
+int DoublyLinkedList_parallelMap(DoublyLinkedList* dll, ThreadPool* pool,
+		E (*fn)(E value, void* context), void* context)
+{
+	if(dll == NULL || fn == NULL) return 1;
+	if(dll->sorted || dll->hashIndex != NULL) return 1;
+	DLLParallelPass pass;
+	size_t count;
+	pass.forEach = NULL;
+	pass.map = fn;
+	pass.combine = NULL;
+	pass.context = context;
+	int result = DoublyLinkedList_runPass(dll, pool, &pass, &count);
+	free(pass.segments);
+	return result;
+}
+/*
+ * Folds the list into result with combine, a segment at a time on the
+ * threads of pool and then over the segments in order. Nonzero on failure.
+ */
+int DoublyLinkedList_parallelReduce(DoublyLinkedList* dll, ThreadPool* pool,
+		E (*combine)(E accumulator, E value, void* context), E identity,
+		void* context, E* result)
+{
+	if(dll == NULL || combine == NULL || result == NULL) return 1;
+	DLLParallelPass pass;
+	size_t count, k;
+	pass.forEach = NULL;
+	pass.map = NULL;
+	pass.combine = combine;
+	pass.identity = identity;
+	pass.context = context;
+	if(DoublyLinkedList_runPass(dll, pool, &pass, &count)) return 1;
+	E accumulator = identity;
+	for(k = 0; k < count; k++)
+		accumulator = combine(accumulator, pass.segments[k].result, context);
+	free(pass.segments);
+	*result = accumulator;
+	return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * DoublyLinkedListParallel - Multi-threaded whole-list operations on a
+ * DoublyLinkedList
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef DOUBLYLINKEDLISTPARALLEL_H
+#define DOUBLYLINKEDLISTPARALLEL_H
+
+/*
+ * These functions use POSIX threads, so link with -pthread (and
+ * ThreadPool.c).
+ */
+#include "DoublyLinkedList.h"
+#include "ThreadPool.h"
+
+/*
+ * parallelForEach, parallelMap and parallelReduce cut the list into
+ * DLL_PARALLEL_SEGMENTS segments of (nearly) equal size, or one per node
+ * on shorter lists, and run the segments as tasks on a ThreadPool. The
+ * cuts depend only on the size of the list, never on the pool, so a
+ * reduction combines the same values in the same order every time, and
+ * gives the same result on any number of threads, or with no pool at all
+ * (pool NULL runs every segment on the calling thread).
+ * Finding the cuts takes O(log n) per cut with a rank index, and otherwise
+ * a walk in from both ends at once, like DLL_DOUBLE_TRAVERSAL, which is
+ * still O(n) but cheap next to the heavy per-node work these are meant for.
+ */
+#define DLL_PARALLEL_SEGMENTS 64
+
+/*
+ * Sorts the list like DoublyLinkedList_sort(), but splits it into up to
+ * threads sublists that are sorted on separate threads, then merged
+ * pairwise, also on separate threads. Lists too short to be worth it are
+ * simply sorted on the calling thread. Nonzero on failure.
+ * note: this function uses DoublyLinkedList.compare iff it's been implemented,
+ * so compare has to be safe to call from several threads at once
+ */
+int DoublyLinkedList_parallelSort(DoublyLinkedList* dll, int threads);
+/*
+ * Calls fn(node, context) once for every node of the list, on the threads
+ * of pool. fn may change node->data (bypassing the hash index, just like
+ * writing to it from a DLL_TRAVERSAL loop would) but must not link or
+ * unlink nodes. Nonzero on failure.
+ */
+int DoublyLinkedList_parallelForEach(DoublyLinkedList* dll, ThreadPool* pool,
+		void (*fn)(DLLNode* node, void* context), void* context);
+/*
+ * Replaces every element of the list with fn(element, context), on the
+ * threads of pool. Nonzero on failure, or if the list is auto-sorted or has
+ * a hash index, since the new values could break either.
+ */
+int DoublyLinkedList_parallelMap(DoublyLinkedList* dll, ThreadPool* pool,
+		E (*fn)(E value, void* context), void* context);
+/*
+ * Folds the list into result with combine, on the threads of pool: each
+ * segment is folded from head to tail starting at identity, and then the
+ * results of the segments are folded from first to last starting at
+ * identity, on the calling thread. combine has to be associative, with
+ * identity as its neutral element, for that to equal a plain fold, but the
+ * order is fixed either way. An empty list reduces to identity.
+ * Nonzero on failure.
+ */
+int DoublyLinkedList_parallelReduce(DoublyLinkedList* dll, ThreadPool* pool,
+		E (*combine)(E accumulator, E value, void* context), E identity,
+		void* context, E* result);
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * DoublyLinkedListSnapshot - Saves DoublyLinkedLists to versioned binary
+ * files whose nodes link by file offset, and maps them back in without
+ * allocating or reading a single node. See DoublyLinkedListSnapshot.h.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "DoublyLinkedListSnapshot.h"
+
+#define DLLSNAPSHOT_MAGIC "DLLSNAP"
+#define DLLSNAPSHOT_BYTE_ORDER 0x01020304u
+
+/*
+ * Returns the file offset of the index-th node.
+ */
+static uint64_t DLLSnapshot_offset(size_t index)
+{
+	return DLLSNAPSHOT_DATA_OFFSET + (uint64_t)index * sizeof(DLLSnapshotNode);
+}
+/*
+ * Returns the node at offset, or NULL if offset is 0 or doesn't point at a
+ * whole node inside the mapping.
+ */
+static const DLLSnapshotNode* DLLSnapshot_node(const DLLSnapshot* snapshot, uint64_t offset)
+{
+	if(offset < DLLSNAPSHOT_DATA_OFFSET || offset > snapshot->length - sizeof(DLLSnapshotNode))
+		return NULL;
+	if((offset - DLLSNAPSHOT_DATA_OFFSET) % sizeof(DLLSnapshotNode) != 0)
+		return NULL;
+	return (const DLLSnapshotNode*)(snapshot->base + offset);
+}
+/*
+ * Writes dll to a temporary file next to path, one node at a time through
+ * stdio's buffer, then renames it over path, so a failed save leaves
+ * whatever was at path untouched. Nonzero on failure.
+ */
+int DoublyLinkedList_saveSnapshot(DoublyLinkedList* dll, const char* path)
+{
+	if(dll == NULL || path == NULL) return 1;
+	size_t length = strlen(path) + 32;
+	char* temporary = (char*)malloc(length);
+	if(temporary == NULL) return 1;
+	snprintf(temporary, length, "%s.tmp.%ld", path, (long)getpid());
+	int fd = open(temporary, O_WRONLY | O_CREAT | O_EXCL, 0666);
+	FILE* file = fd < 0 ? NULL : fdopen(fd, "wb");
+	if(file == NULL)
+	{
+		if(fd >= 0)
+		{
+			close(fd);
+			unlink(temporary);
+		}
+		free(temporary);
+		return 1;
+	}
+	char header[DLLSNAPSHOT_DATA_OFFSET];
+	DLLSnapshotHeader fields;
+	memset(header, 0, sizeof(header));
+	memset(&fields, 0, sizeof(fields));
+	memcpy(fields.magic, DLLSNAPSHOT_MAGIC, sizeof(DLLSNAPSHOT_MAGIC));
+	fields.version = DLLSNAPSHOT_VERSION;
+	fields.byteOrder = DLLSNAPSHOT_BYTE_ORDER;
+	fields.elementSize = sizeof(E);
+	fields.nodeSize = sizeof(DLLSnapshotNode);
+	fields.size = dll->size;
+	fields.head = dll->size ? DLLSnapshot_offset(0) : 0;
+	fields.tail = dll->size ? DLLSnapshot_offset(dll->size - 1) : 0;
+	memcpy(header, &fields, sizeof(fields));
+	int failed = fwrite(header, sizeof(header), 1, file) != 1;
+	DLLNode* node;
+	size_t i = 0;
+	DLL_TRAVERSAL(dll, node)
+	{
+		if(failed) break;
+		DLLSnapshotNode record;
+		// zero the padding too, so equal lists make equal files
+		memset(&record, 0, sizeof(record));
+		record.data = node->data;
+		record.next = node->next != NULL ? DLLSnapshot_offset(i + 1) : 0;
+		record.prev = i > 0 ? DLLSnapshot_offset(i - 1) : 0;
+		failed = fwrite(&record, sizeof(record), 1, file) != 1;
+		i++;
+	}
+	if(fclose(file) != 0) failed = 1;
+	if(!failed && rename(temporary, path) != 0) failed = 1;
+	if(failed) unlink(temporary);
+	free(temporary);
+	return failed;
+}
+/*
+ * Maps the snapshot file at path and checks its header. Returns NULL on
+ * failure.
+ */
+DLLSnapshot* DLLSnapshot_open(const char* path)
+{
+	if(path == NULL) return NULL;
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) return NULL;
+	struct stat info;
+	if(fstat(fd, &info) != 0 || (size_t)info.st_size < DLLSNAPSHOT_DATA_OFFSET)
+	{
+		close(fd);
+		return NULL;
+	}
+	size_t length = (size_t)info.st_size;
+	void* base = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after the descriptor is closed
+	close(fd);
+	if(base == MAP_FAILED) return NULL;
+	const DLLSnapshotHeader* header = (const DLLSnapshotHeader*)base;
+	if(memcmp(header->magic, DLLSNAPSHOT_MAGIC, sizeof(DLLSNAPSHOT_MAGIC)) != 0 ||
+			header->version != DLLSNAPSHOT_VERSION ||
+			header->byteOrder != DLLSNAPSHOT_BYTE_ORDER ||
+			header->elementSize != sizeof(E) ||
+			header->nodeSize != sizeof(DLLSnapshotNode) ||
+			header->size > (length - DLLSNAPSHOT_DATA_OFFSET) / sizeof(DLLSnapshotNode))
+	{
+		munmap(base, length);
+		return NULL;
+	}
+	DLLSnapshot* snapshot = (DLLSnapshot*)malloc(sizeof(DLLSnapshot));
+	if(snapshot == NULL)
+	{
+		munmap(base, length);
+		return NULL;
+	}
+	snapshot->base = (const char*)base;
+	snapshot->length = length;
+	snapshot->header = header;
+	return snapshot;
+}
+/*
+ * Unmaps a snapshot
+ */
+void DLLSnapshot_close(DLLSnapshot* snapshot)
+{
+	if(snapshot == NULL) return;
+	munmap((void*)snapshot->base, snapshot->length);
+	free(snapshot);
+}
+/*
+ * Returns the number of elements in the snapshot
+ */
+size_t DLLSnapshot_getSize(const DLLSnapshot* snapshot)
+{
+	if(snapshot == NULL) return 0;
+	return (size_t)snapshot->header->size;
+}
+/*
+ * Returns the head node of the snapshot
+ */
+const DLLSnapshotNode* DLLSnapshot_getHead(const DLLSnapshot* snapshot)
+{
+	return DLLSnapshot_node(snapshot, snapshot->header->head);
+}
+/*
+ * Returns the tail node of the snapshot
+ */
+const DLLSnapshotNode* DLLSnapshot_getTail(const DLLSnapshot* snapshot)
+{
+	return DLLSnapshot_node(snapshot, snapshot->header->tail);
+}
+/*
+ * Returns the node after node
+ */
+const DLLSnapshotNode* DLLSnapshot_getNext(const DLLSnapshot* snapshot, const DLLSnapshotNode* node)
+{
+	return DLLSnapshot_node(snapshot, node->next);
+}
+/*
+ * Returns the node before node
+ */
+const DLLSnapshotNode* DLLSnapshot_getPrev(const DLLSnapshot* snapshot, const DLLSnapshotNode* node)
+{
+	return DLLSnapshot_node(snapshot, node->prev);
+}
+/*
+ * Copies every element of the snapshot onto the tail of dll, reserving
+ * pool nodes up front if dll has a pool. Nonzero on failure, after popping
+ * whatever had been copied already.
+ */
+int DLLSnapshot_load(const DLLSnapshot* snapshot, DoublyLinkedList* dll)
+{
+	if(snapshot == NULL || dll == NULL) return 1;
+	if(dll->sorted && dll->size > 0) return 1;
+	if(dll->pool != NULL && DLLNodePool_reserve(dll->pool, DLLSnapshot_getSize(snapshot)))
+		return 1;
+	const DLLSnapshotNode* node;
+	size_t count = 0, size = dll->size;
+	short int sorted = dll->sorted;
+	DLLSNAPSHOT_TRAVERSAL(snapshot, node)
+	{
+		// a damaged file could link nodes in a loop
+		if(count++ == snapshot->header->size || DoublyLinkedList_pushTail(dll, node->data))
+		{
+			while(dll->size > size)
+				DoublyLinkedList_popTail(dll);
+			dll->sorted = sorted;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * DoublyLinkedListSnapshot - Binary snapshots of DoublyLinkedLists that
+ * can be memory-mapped back in
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef DOUBLYLINKEDLISTSNAPSHOT_H
+#define DOUBLYLINKEDLISTSNAPSHOT_H
+
+#include <stdint.h>
+#include "DoublyLinkedList.h"
+
+/*
+ * Traverses a snapshot from head to tail
+ * Usage:
+ * const DLLSnapshotNode* handle;
+ * DLLSNAPSHOT_TRAVERSAL(snapshot, handle)
+ * {
+ *      [handle->data is the current element]
+ * }
+ */
+#define DLLSNAPSHOT_TRAVERSAL(SNAPSHOT, NODE)							\
+	for(NODE = DLLSnapshot_getHead(SNAPSHOT); NODE != NULL;				\
+			NODE = DLLSnapshot_getNext(SNAPSHOT, NODE))
+
+#define DLLSNAPSHOT_VERSION 1
+#define DLLSNAPSHOT_DATA_OFFSET 64	// where the first node starts in the file
+
+/*
+ * A snapshot file is a DLLSnapshotHeader followed, at
+ * DLLSNAPSHOT_DATA_OFFSET, by one DLLSnapshotNode per element in list order.
+ * next and prev are byte offsets from the start of the file (0 for none)
+ * instead of pointers, so a mapped file is a list as it is, wherever it
+ * lands in memory. All numbers are in the byte order of the machine that
+ * wrote the file; byteOrder tells a reader whether that's its own.
+ */
+typedef struct
+{
+	char magic[8];			// "DLLSNAP" and a NUL
+	uint32_t version;		// DLLSNAPSHOT_VERSION
+	uint32_t byteOrder;		// 0x01020304 as written
+	uint32_t elementSize;	// sizeof(E)
+	uint32_t nodeSize;		// sizeof(DLLSnapshotNode)
+	uint64_t size;			// number of nodes
+	uint64_t head;			// offset of the head node, 0 if empty
+	uint64_t tail;			// offset of the tail node, 0 if empty
+}DLLSnapshotHeader;
+
+typedef struct
+{
+	E data;
+	uint64_t next;
+	uint64_t prev;
+}DLLSnapshotNode;
+
+/*
+ * A DLLSnapshot is a snapshot file mapped read-only into memory. Opening
+ * one reads nothing but the header, so it takes the same time however
+ * long the list is, and the nodes are only paged in as they're walked.
+ */
+typedef struct
+{
+	const char* base;		// the mapping
+	size_t length;			// bytes mapped
+	const DLLSnapshotHeader* header;
+}DLLSnapshot;
+
+/*
+ * Writes dll to a snapshot file at path, replacing it. The file is written
+ * under a temporary name and renamed over path once complete, so path is
+ * never left truncated. Nonzero on failure.
+ */
+int DoublyLinkedList_saveSnapshot(DoublyLinkedList* dll, const char* path);
+/*
+ * Maps the snapshot file at path. Returns NULL if it can't be opened or
+ * isn't a snapshot of this version, element size and byte order.
+ */
+DLLSnapshot* DLLSnapshot_open(const char* path);
+/*
+ * Unmaps a snapshot. Its nodes can't be used afterwards.
+ */
+void DLLSnapshot_close(DLLSnapshot* snapshot);
+/*
+ * Returns the number of elements in the snapshot.
+ */
+size_t DLLSnapshot_getSize(const DLLSnapshot* snapshot);
+/*
+ * Returns the head node of the snapshot, or NULL if it's empty.
+ */
+const DLLSnapshotNode* DLLSnapshot_getHead(const DLLSnapshot* snapshot);
+/*
+ * Returns the tail node of the snapshot, or NULL if it's empty.
+ */
+const DLLSnapshotNode* DLLSnapshot_getTail(const DLLSnapshot* snapshot);
+/*
+ * Returns the node after node, or NULL at the tail (or if the link points
+ * outside of the file).
+ */
+const DLLSnapshotNode* DLLSnapshot_getNext(const DLLSnapshot* snapshot, const DLLSnapshotNode* node);
+/*
+ * Returns the node before node, or NULL at the head (or if the link points
+ * outside of the file).
+ */
+const DLLSnapshotNode* DLLSnapshot_getPrev(const DLLSnapshot* snapshot, const DLLSnapshotNode* node);
+/*
+ * Copies every element of the snapshot onto the tail of dll, for when the
+ * list has to be changed. Nonzero on failure, in which case dll is left as
+ * it was, or if dll is auto-sorted and not empty.
+ */
+int DLLSnapshot_load(const DLLSnapshot* snapshot, DoublyLinkedList* dll);
+
+#endif
@@ -0,0 +1,166 @@
+/*
+ * IntrusiveList - A doubly-linked list of links embedded in the caller's
+ * own structs, which it never allocates or frees. See IntrusiveList.h.
+ */
+#include <assert.h>
+#include "IntrusiveList.h"
+
+/*
+ * Empties list
+ */
+void IntrusiveList_init(IntrusiveList* list)
+{
+	list->head = NULL;
+	list->tail = NULL;
+	list->size = 0;
+}
+/*
+ * Marks node as in no list
+ */
+void IntrusiveList_initNode(ILNode* node)
+{
+	node->next = NULL;
+	node->prev = NULL;
+	node->list = NULL;
+}
+/*
+ * Makes node the only node of the empty list
+ */
+static void IntrusiveList_first(IntrusiveList* list, ILNode* node)
+{
+	node->next = NULL;
+	node->prev = NULL;
+	node->list = list;
+	list->head = node;
+	list->tail = node;
+	list->size = 1;
+}
+/*
+ * Links node at the tail end of the list
+ */
+void IntrusiveList_pushTail(IntrusiveList* list, ILNode* node)
+{
+	assert(node->list == NULL);
+	if(list->size == 0)
+		IntrusiveList_first(list, node);
+	else
+		IntrusiveList_insertAfter(list->tail, node);
+}
+/*
+ * Links node at the head end of the list
+ */
+void IntrusiveList_pushHead(IntrusiveList* list, ILNode* node)
+{
+	assert(node->list == NULL);
+	if(list->size == 0)
+		IntrusiveList_first(list, node);
+	else
+		IntrusiveList_insertBefore(list->head, node);
+}
+/*
+ * Unlinks and returns the tail, or NULL if the list is empty
+ */
+ILNode* IntrusiveList_popTail(IntrusiveList* list)
+{
+	ILNode* node = list->tail;
+	if(node != NULL) IntrusiveList_remove(node);
+	return node;
+}
+/*
+ * Unlinks and returns the head, or NULL if the list is empty
+ */
+ILNode* IntrusiveList_popHead(IntrusiveList* list)
+{
+	ILNode* node = list->head;
+	if(node != NULL) IntrusiveList_remove(node);
+	return node;
+}
+/*
+ * Links node right after handle
+ */
+void IntrusiveList_insertAfter(ILNode* handle, ILNode* node)
+{
+	assert(handle->list != NULL && node->list == NULL);
+	IntrusiveList* list = handle->list;
+	node->list = list;
+	node->prev = handle;
+	node->next = handle->next;
+	if(handle->next != NULL)
+		handle->next->prev = node;
+	else
+		list->tail = node;
+	handle->next = node;
+	list->size++;
+}
+/*
+ * Links node right before handle
+ */
+void IntrusiveList_insertBefore(ILNode* handle, ILNode* node)
+{
+	assert(handle->list != NULL && node->list == NULL);
+	IntrusiveList* list = handle->list;
+	node->list = list;
+	node->next = handle;
+	node->prev = handle->prev;
+	if(handle->prev != NULL)
+		handle->prev->next = node;
+	else
+		list->head = node;
+	handle->prev = node;
+	list->size++;
+}
+/*
+ * Unlinks node from its list. Nonzero if node is in no list.
+ */
+int IntrusiveList_remove(ILNode* node)
+{
+	if(node == NULL || node->list == NULL) return 1;
+	IntrusiveList* list = node->list;
+	if(node->prev != NULL)
+		node->prev->next = node->next;
+	else
+		list->head = node->next;
+	if(node->next != NULL)
+		node->next->prev = node->prev;
+	else
+		list->tail = node->prev;
+	list->size--;
+	IntrusiveList_initNode(node);
+	return 0;
+}
+/*
+ * Returns 1 if node is in a list, 0 if not
+ */
+int IntrusiveList_isLinked(const ILNode* node)
+{
+	return node->list != NULL;
+}
+/*
+ * Returns the number of nodes in the list
+ */
+size_t IntrusiveList_getSize(const IntrusiveList* list)
+{
+	return list->size;
+}
+/*
+ * Moves every node of src onto the tail of dst, leaving src empty. Every
+ * moved node has to be told its new list, so this is O(1) in links but
+ * O(src->size) in all.
+ */
+void IntrusiveList_splice(IntrusiveList* dst, IntrusiveList* src)
+{
+	if(src == dst || src->size == 0) return;
+	ILNode* node;
+	for(node = src->head; node != NULL; node = node->next)
+		node->list = dst;
+	if(dst->size == 0)
+		dst->head = src->head;
+	else
+	{
+		dst->tail->next = src->head;
+		src->head->prev = dst->tail;
+	}
+	dst->tail = src->tail;
+	dst->size += src->size;
+	IntrusiveList_init(src);
+}
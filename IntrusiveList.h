@@ -0,0 +1,135 @@
+/*
+ * IntrusiveList - A DoublyLinkedList whose links live inside the caller's
+ * own structs
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef INTRUSIVELIST_H
+#define INTRUSIVELIST_H
+
+#include <stddef.h>
+
+/*
+ * Returns the TYPE* whose MEMBER field is at PTR.
+ * Usage:
+ * typedef struct { int id; ILNode link; } Record;
+ * Record* record = IL_CONTAINER_OF(node, Record, link);
+ */
+#define IL_CONTAINER_OF(PTR, TYPE, MEMBER)								\
+	((TYPE*)((char*)(PTR) - offsetof(TYPE, MEMBER)))
+
+/*
+ * Same as IL_CONTAINER_OF, but NULL stays NULL.
+ */
+#define IL_ENTRY(PTR, TYPE, MEMBER)										\
+	((PTR) != NULL ? IL_CONTAINER_OF(PTR, TYPE, MEMBER) : (TYPE*)NULL)
+
+/*
+ * Traverses the list from head to tail, one containing struct at a time
+ * Usage:
+ * Record* record;
+ * IL_TRAVERSAL(list, record, Record, link)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and record points to the current struct]
+ * }
+ */
+#define IL_TRAVERSAL(IL, ENTRY, TYPE, MEMBER)							\
+	for(ENTRY = IL_ENTRY((IL)->head, TYPE, MEMBER); ENTRY != NULL;		\
+		ENTRY = IL_ENTRY(ENTRY->MEMBER.next, TYPE, MEMBER))
+
+/*
+ * Traverses the list from tail to head
+ * Usage:
+ * Record* record;
+ * IL_REVERSE_TRAVERSAL(list, record, Record, link)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and record points to the current struct]
+ * }
+ */
+#define IL_REVERSE_TRAVERSAL(IL, ENTRY, TYPE, MEMBER)					\
+	for(ENTRY = IL_ENTRY((IL)->tail, TYPE, MEMBER); ENTRY != NULL;		\
+		ENTRY = IL_ENTRY(ENTRY->MEMBER.prev, TYPE, MEMBER))
+
+/*
+ * An ILNode is the link a struct embeds to be kept in an IntrusiveList. It
+ * holds no data: the struct around it is the element, found back from the
+ * node with IL_CONTAINER_OF. list is NULL while the node is in no list.
+ * A struct can sit in several lists at once by embedding several ILNodes.
+ */
+typedef struct ILNode
+{
+	struct ILNode* next;
+	struct ILNode* prev;
+	struct IntrusiveList* list;
+}ILNode;
+
+/*
+ * An IntrusiveList has the head/tail/size layout of a DoublyLinkedList,
+ * but since its nodes belong to the caller it never allocates or frees
+ * anything: inserting and removing only rewrite links, and the caller
+ * decides where the structs live and when they die. It can be declared on
+ * the stack or inside another struct and set up with IntrusiveList_init.
+ */
+typedef struct IntrusiveList
+{
+	ILNode* head;
+	ILNode* tail;
+	size_t size;
+}IntrusiveList;
+
+/*
+ * Empties list. Nodes still in it are not touched.
+ */
+void IntrusiveList_init(IntrusiveList* list);
+/*
+ * Prepares a node to be inserted, marking it as in no list.
+ */
+void IntrusiveList_initNode(ILNode* node);
+/*
+ * Links node at the tail end of the list. node must not be in any list.
+ */
+void IntrusiveList_pushTail(IntrusiveList* list, ILNode* node);
+/*
+ * Links node at the head end of the list. node must not be in any list.
+ */
+void IntrusiveList_pushHead(IntrusiveList* list, ILNode* node);
+/*
+ * Unlinks and returns the tail, or NULL if the list is empty.
+ */
+ILNode* IntrusiveList_popTail(IntrusiveList* list);
+/*
+ * Unlinks and returns the head, or NULL if the list is empty.
+ */
+ILNode* IntrusiveList_popHead(IntrusiveList* list);
+/*
+ * Links node right after handle, in handle's list. node must not be in any
+ * list.
+ */
+void IntrusiveList_insertAfter(ILNode* handle, ILNode* node);
+/*
+ * Links node right before handle, in handle's list. node must not be in
+ * any list.
+ */
+void IntrusiveList_insertBefore(ILNode* handle, ILNode* node);
+/*
+ * Unlinks node from whatever list it's in. The struct around it is left
+ * alone. Nonzero if node is in no list.
+ */
+int IntrusiveList_remove(ILNode* node);
+/*
+ * Returns 1 if node is in a list, 0 if not.
+ */
+int IntrusiveList_isLinked(const ILNode* node);
+/*
+ * Returns the number of nodes in the list.
+ */
+size_t IntrusiveList_getSize(const IntrusiveList* list);
+/*
+ * Moves every node of src onto the tail of dst, leaving src empty. Only
+ * the two ends are relinked, but each node is told its new list.
+ */
+void IntrusiveList_splice(IntrusiveList* dst, IntrusiveList* src);
+
+#endif
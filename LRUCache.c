@@ -0,0 +1,291 @@
+/*
+ * LRUCache - A least-recently-used cache from keys to values of type E,
+ * which are generic and can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#include <stdlib.h>
+#include <assert.h>
+#include "LRUCache.h"
+#include "DoublyLinkedList.h"
+
+/*
+ * An LRUEntry sits in the recency list through link and in one slot of the
+ * hash table, which keeps its hash so the table can grow without rehashing.
+ */
+typedef struct LRUEntry
+{
+	ILNode link;
+	E key;
+	E value;
+	size_t weight;
+	size_t hash;
+}LRUEntry;
+
+/*
+ * Compares two keys with cache->compare if it's been implemented, or with
+ * '==' otherwise. Returns 1 if they're equal.
+ */
+static int LRUCache_equals(LRUCache* cache, E key1, E key2)
+{
+	if(cache->compare) return cache->compare(key1, key2) == 0;
+	return key1 == key2;
+}
+/*
+ * Returns the slot holding the entry for key, or the empty slot where it
+ * would go.
+ */
+static size_t LRUCache_slot(LRUCache* cache, E key, size_t hash)
+{
+	size_t mask = cache->slotCount - 1;
+	size_t i = hash & mask;
+	while(cache->slots[i] != NULL &&
+			(cache->slots[i]->hash != hash || !LRUCache_equals(cache, cache->slots[i]->key, key)))
+		i = (i + 1) & mask;
+	return i;
+}
+/*
+ * Moves every entry into a new table of slotCount slots. Nonzero on failure.
+ */
+static int LRUCache_resize(LRUCache* cache, size_t slotCount)
+{
+	LRUEntry** slots = (LRUEntry**)calloc(slotCount, sizeof(LRUEntry*));
+	if(slots == NULL) return 1;
+	free(cache->slots);
+	cache->slots = slots;
+	cache->slotCount = slotCount;
+	size_t mask = slotCount - 1;
+	LRUEntry* entry;
+	IL_TRAVERSAL(&cache->order, entry, LRUEntry, link)
+	{
+		size_t i = entry->hash & mask;
+		while(slots[i] != NULL)
+			i = (i + 1) & mask;
+		slots[i] = entry;
+	}
+	return 0;
+}
+/*
+ * Empties slot i of the hash table, shifting later slots back so that no
+ * probe sequence is broken.
+ */
+static void LRUCache_clearSlot(LRUCache* cache, size_t i)
+{
+	size_t mask = cache->slotCount - 1;
+	size_t j = i;
+	for(;;)
+	{
+		j = (j + 1) & mask;
+		if(cache->slots[j] == NULL) break;
+		size_t k = cache->slots[j]->hash & mask;
+		// move slot j back into the hole at i unless its home lies in (i, j]
+		if((j > i && (k <= i || k > j)) || (j < i && (k <= i && k > j)))
+		{
+			cache->slots[i] = cache->slots[j];
+			i = j;
+		}
+	}
+	cache->slots[i] = NULL;
+}
+/*
+ * Unlinks the entry in slot i from the list and the table and deallocates
+ * it.
+ */
+static void LRUCache_drop(LRUCache* cache, size_t i)
+{
+	LRUEntry* entry = cache->slots[i];
+	LRUCache_clearSlot(cache, i);
+	IntrusiveList_remove(&entry->link);
+	cache->weight -= entry->weight;
+	free(entry);
+}
+/*
+ * Evicts the least recently used entry.
+ */
+static void LRUCache_evictTail(LRUCache* cache)
+{
+	LRUEntry* entry = IL_CONTAINER_OF(cache->order.tail, LRUEntry, link);
+	E key = entry->key, value = entry->value;
+	LRUCache_drop(cache, LRUCache_slot(cache, key, entry->hash));
+	cache->evictions++;
+	if(cache->evict != NULL) cache->evict(key, value, cache->evictContext);
+}
+/*
+ * Allocates an empty LRUCache
+ */
+LRUCache* LRUCache_create(size_t capacity, size_t maxWeight, size_t (*hash)(E key))
+{
+	LRUCache* cache = (LRUCache*)malloc(sizeof(LRUCache));
+	if(cache == NULL) return NULL;
+	// the table gets 2 to 4 slots per entry, which has to fit in a size_t
+	if(capacity > (size_t)-1 / 4 / sizeof(LRUEntry*))
+	{
+		free(cache);
+		return NULL;
+	}
+	IntrusiveList_init(&cache->order);
+	// keep the table at most half full when the cache is
+	cache->slotCount = 16;
+	while(cache->slotCount < capacity * 2)
+		cache->slotCount *= 2;
+	cache->slots = (LRUEntry**)calloc(cache->slotCount, sizeof(LRUEntry*));
+	if(cache->slots == NULL)
+	{
+		free(cache);
+		return NULL;
+	}
+	cache->capacity = capacity;
+	cache->maxWeight = maxWeight;
+	cache->weight = 0;
+	cache->hash = hash ? hash : DoublyLinkedList_hash;
+	cache->compare = NULL;
+	cache->evict = NULL;
+	cache->evictContext = NULL;
+	LRUCache_resetCounters(cache);
+	return cache;
+}
+/*
+ * Drops every entry through the evict callback and deallocates the cache
+ */
+void LRUCache_free(LRUCache* cache)
+{
+	if(cache == NULL) return;
+	ILNode* node;
+	while((node = IntrusiveList_popHead(&cache->order)) != NULL)
+	{
+		LRUEntry* entry = IL_CONTAINER_OF(node, LRUEntry, link);
+		if(cache->evict != NULL) cache->evict(entry->key, entry->value, cache->evictContext);
+		free(entry);
+	}
+	free(cache->slots);
+	free(cache);
+}
+/*
+ * Sets the function called with every evicted entry
+ */
+void LRUCache_setEvictCallback(LRUCache* cache, LRUEvictFunction evict, void* context)
+{
+	assert(cache != NULL);
+	cache->evict = evict;
+	cache->evictContext = context;
+}
+/*
+ * Looks key up and makes it the most recently used entry. Nonzero on a
+ * miss.
+ */
+int LRUCache_get(LRUCache* cache, E key, E* value)
+{
+	assert(cache != NULL);
+	LRUEntry* entry = cache->slots[LRUCache_slot(cache, key, cache->hash(key))];
+	if(entry == NULL)
+	{
+		cache->misses++;
+		return 1;
+	}
+	cache->hits++;
+	if(cache->order.head != &entry->link)
+	{
+		IntrusiveList_remove(&entry->link);
+		IntrusiveList_pushHead(&cache->order, &entry->link);
+	}
+	if(value != NULL) *value = entry->value;
+	return 0;
+}
+/*
+ * Looks key up without touching the order or the counters. Nonzero if key
+ * isn't cached.
+ */
+int LRUCache_peek(LRUCache* cache, E key, E* value)
+{
+	assert(cache != NULL);
+	LRUEntry* entry = cache->slots[LRUCache_slot(cache, key, cache->hash(key))];
+	if(entry == NULL) return 1;
+	if(value != NULL) *value = entry->value;
+	return 0;
+}
+/*
+ * Caches value under key, then evicts until the cache is within its limits.
+ * Nonzero on failure.
+ */
+int LRUCache_put(LRUCache* cache, E key, E value, size_t weight)
+{
+	assert(cache != NULL);
+	if(cache->maxWeight && weight > cache->maxWeight) return 1;
+	size_t hash = cache->hash(key);
+	size_t i = LRUCache_slot(cache, key, hash);
+	LRUEntry* entry = cache->slots[i];
+	int replaced = entry != NULL;
+	E oldKey = key, oldValue = value;
+	if(replaced)
+	{
+		// replacing an entry reuses it in place
+		IntrusiveList_remove(&entry->link);
+		cache->weight -= entry->weight;
+		oldKey = entry->key;
+		oldValue = entry->value;
+		entry->key = key;
+	}
+	else
+	{
+		if((cache->order.size + 1) * 2 > cache->slotCount)
+		{
+			if(LRUCache_resize(cache, cache->slotCount * 2)) return 1;
+			i = LRUCache_slot(cache, key, hash);
+		}
+		entry = (LRUEntry*)malloc(sizeof(LRUEntry));
+		if(entry == NULL) return 1;
+		entry->key = key;
+		entry->hash = hash;
+		cache->slots[i] = entry;
+	}
+	entry->value = value;
+	entry->weight = weight;
+	cache->weight += weight;
+	IntrusiveList_initNode(&entry->link);
+	IntrusiveList_pushHead(&cache->order, &entry->link);
+	// the replaced pair is released like an evicted one, but isn't counted
+	if(replaced && cache->evict != NULL) cache->evict(oldKey, oldValue, cache->evictContext);
+	// the new entry is at the head, so it's the last one evicted
+	while((cache->capacity && cache->order.size > cache->capacity) ||
+			(cache->maxWeight && cache->weight > cache->maxWeight))
+		LRUCache_evictTail(cache);
+	return 0;
+}
+/*
+ * Drops the entry for key without calling the evict callback. Nonzero if
+ * key isn't cached.
+ */
+int LRUCache_remove(LRUCache* cache, E key, E* value)
+{
+	assert(cache != NULL);
+	size_t i = LRUCache_slot(cache, key, cache->hash(key));
+	if(cache->slots[i] == NULL) return 1;
+	if(value != NULL) *value = cache->slots[i]->value;
+	LRUCache_drop(cache, i);
+	return 0;
+}
+/*
+ * Returns the number of entries in the cache
+ */
+size_t LRUCache_getSize(LRUCache* cache)
+{
+	assert(cache != NULL);
+	return cache->order.size;
+}
+/*
+ * Returns the total weight of the entries in the cache
+ */
+size_t LRUCache_getWeight(LRUCache* cache)
+{
+	assert(cache != NULL);
+	return cache->weight;
+}
+/*
+ * Zeroes the hits, misses and evictions counters
+ */
+void LRUCache_resetCounters(LRUCache* cache)
+{
+	assert(cache != NULL);
+	cache->hits = 0;
+	cache->misses = 0;
+	cache->evictions = 0;
+}
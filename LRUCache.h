@@ -0,0 +1,128 @@
+/*
+ * LRUCache - A least-recently-used cache from keys to values
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <stddef.h>
+#include "IntrusiveList.h"
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h. Keys and values
+ * are both E's, so either can be a pointer cast into an E.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing LRUCache.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+/*
+ * Called with every entry the cache drops to make room, with the old key
+ * and value of every entry a put replaces, and with every entry left when
+ * it's freed, so they can be released if need be.
+ */
+typedef void (*LRUEvictFunction)(E key, E value, void* context);
+
+/*
+ * An LRUEntry is one key and its value, private to LRUCache.c.
+ */
+struct LRUEntry;
+
+/*
+ * An LRUCache keeps its entries in an IntrusiveList from most to least
+ * recently used, and finds them by key through an open-addressing hash
+ * table. That table can't be a DoublyLinkedList with a hash index: the
+ * index hashes and finds a node by its one E, while an entry has a key, a
+ * value and a weight, so the value and weight would need a second table
+ * keyed all over again, and every hit would go through both. A hit relinks its entry at the head of the list without
+ * allocating anything, and a put that goes over capacity entries or
+ * maxWeight total weight evicts from the tail until it fits again.
+ * Either limit can be 0 for none.
+ * Keys are compared with compare if it's been implemented, or '=='
+ * otherwise, and hashed with hash, which has to agree with the comparison
+ * (see DoublyLinkedList_enableHashIndex).
+ * hits, misses and evictions count what the cache has done since it was
+ * created or LRUCache_resetCounters was last called.
+ */
+typedef struct
+{
+	IntrusiveList order;			// most recently used at the head
+	struct LRUEntry** slots;		// hash table, NULL for an empty slot
+	size_t slotCount;				// always a power of 2
+	size_t capacity;				// most entries, 0 for no limit
+	size_t maxWeight;				// most total weight, 0 for no limit
+	size_t weight;					// total weight of the entries
+	size_t (*hash)(E key);
+	int (*compare)(E key1, E key2);
+	LRUEvictFunction evict;
+	void* evictContext;
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+}LRUCache;
+
+/*
+ * Allocates an empty LRUCache holding at most capacity entries and
+ * maxWeight total weight, either of which can be 0 for no limit. If hash
+ * is NULL, DoublyLinkedList_hash() is used. Returns NULL on failure, or if
+ * capacity is too large for the hash table to be sized.
+ */
+LRUCache* LRUCache_create(size_t capacity, size_t maxWeight, size_t (*hash)(E key));
+/*
+ * Drops every entry, passing each to the evict callback if there is one,
+ * and deallocates the cache.
+ */
+void LRUCache_free(LRUCache* cache);
+/*
+ * Sets the function called with every evicted entry, along with context.
+ * NULL for none.
+ */
+void LRUCache_setEvictCallback(LRUCache* cache, LRUEvictFunction evict, void* context);
+/*
+ * Looks key up, copying its value into value if it isn't NULL and making
+ * it the most recently used entry. Counts a hit or a miss.
+ * Nonzero on a miss.
+ */
+int LRUCache_get(LRUCache* cache, E key, E* value);
+/*
+ * Same as LRUCache_get, but leaves the order of the entries and the
+ * counters alone. Nonzero if key isn't cached.
+ */
+int LRUCache_peek(LRUCache* cache, E key, E* value);
+/*
+ * Caches value under key with the given weight, replacing what was cached
+ * under key before, and makes it the most recently used entry. A replaced
+ * key and value go to the evict callback (without counting as an
+ * eviction), and the entry keeps the new key, so don't put the very same
+ * key or value back if the callback releases them. Then evicts
+ * least recently used entries until the cache is within its limits again.
+ * Nonzero on failure, or if weight alone is over maxWeight; the cache is
+ * left as it was in either case.
+ */
+int LRUCache_put(LRUCache* cache, E key, E value, size_t weight);
+/*
+ * Drops the entry for key without calling the evict callback, copying its
+ * value into value if it isn't NULL. Nonzero if key isn't cached.
+ */
+int LRUCache_remove(LRUCache* cache, E key, E* value);
+/*
+ * Returns the number of entries in the cache.
+ */
+size_t LRUCache_getSize(LRUCache* cache);
+/*
+ * Returns the total weight of the entries in the cache.
+ */
+size_t LRUCache_getWeight(LRUCache* cache);
+/*
+ * Zeroes the hits, misses and evictions counters.
+ */
+void LRUCache_resetCounters(LRUCache* cache);
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * LockFreeArena - Segmented, never-shrinking node storage shared by the
+ * lock-free containers. See LockFreeArena.h.
+ */
+#include <stdlib.h>
+#include "LockFreeArena.h"
+
+/*
+ * Prepares an arena for nodes of nodeSize bytes.
+ */
+void LockFreeArena_init(LockFreeArena* arena, size_t nodeSize)
+{
+	int k;
+	for(k = 0; k < LFA_MAX_SEGMENTS; k++)
+		atomic_init(&arena->segments[k], NULL);
+	arena->nodeSize = nodeSize;
+	atomic_init(&arena->freeList, LFA_TAGGED(0, LFA_NULL));
+	atomic_init(&arena->unused, 0);
+}
+/*
+ * Deallocates every segment of the arena.
+ */
+void LockFreeArena_destroy(LockFreeArena* arena)
+{
+	int k;
+	for(k = 0; k < LFA_MAX_SEGMENTS; k++)
+	{
+		free(atomic_load(&arena->segments[k]));
+		atomic_store(&arena->segments[k], NULL);
+	}
+}
+/*
+ * Hands out the index of a node, recycling a released one if there is any.
+ * Returns LFA_NULL on failure.
+ */
+uint32_t LockFreeArena_alloc(LockFreeArena* arena)
+{
+	uint64_t top = atomic_load(&arena->freeList);
+	while(LFA_INDEX(top) != LFA_NULL)
+	{
+		_Atomic uint64_t* link = (_Atomic uint64_t*)LockFreeArena_get(arena, LFA_INDEX(top));
+		uint64_t next = LFA_INDEX(atomic_load(link));
+		if(atomic_compare_exchange_weak(&arena->freeList, &top,
+				LFA_TAGGED(LFA_TAG(top) + 1, next)))
+			return LFA_INDEX(top);
+	}
+	uint32_t index = atomic_fetch_add(&arena->unused, 1);
+	if(index >= LFA_NULL)
+	{
+		atomic_fetch_sub(&arena->unused, 1);
+		return LFA_NULL;
+	}
+	uint32_t offset = index;
+	unsigned int k = LockFreeArena_segment(&offset);
+	if(k >= LFA_MAX_SEGMENTS) return LFA_NULL;
+	if(atomic_load(&arena->segments[k]) == NULL)
+	{
+		// whoever loses the race to publish the segment throws theirs away
+		char* segment = (char*)calloc((size_t)1 << (k + LFA_SEGMENT_SHIFT), arena->nodeSize);
+		char* expected = NULL;
+		if(segment == NULL) return LFA_NULL;
+		if(!atomic_compare_exchange_strong(&arena->segments[k], &expected, segment))
+			free(segment);
+	}
+	return index;
+}
+/*
+ * Gives a node back to the arena by pushing it on the free list. The tag of
+ * its link field keeps counting up, so a container that compares-and-swaps
+ * that field can't mistake this node's next life for its last one.
+ */
+void LockFreeArena_release(LockFreeArena* arena, uint32_t index)
+{
+	_Atomic uint64_t* link = (_Atomic uint64_t*)LockFreeArena_get(arena, index);
+	uint32_t tag = LFA_TAG(atomic_load(link)) + 1;
+	uint64_t top = atomic_load(&arena->freeList);
+	do
+	{
+		atomic_store(link, LFA_TAGGED(tag, LFA_INDEX(top)));
+	}while(!atomic_compare_exchange_weak(&arena->freeList, &top,
+			LFA_TAGGED(LFA_TAG(top) + 1, index)));
+}
@@ -0,0 +1,89 @@
+/*
+ * LockFreeArena - Node storage for the lock-free containers
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef LOCKFREEARENA_H
+#define LOCKFREEARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+ * A LockFreeArena hands out fixed-size nodes by 32-bit index, from any
+ * number of threads at once and without locks. Nodes live in segments that
+ * are never given back until the arena is freed, so a thread that still
+ * holds the index of a node someone else released can always read it
+ * safely. Released nodes are recycled through a lock-free free list.
+ *
+ * Lock-free containers link their nodes by index and pack a 32-bit tag next
+ * to it in a uint64_t (see LFA_TAGGED), bumping the tag on every change, so
+ * a compare-and-swap never mistakes a recycled node for the one it read
+ * (the ABA problem).
+ *
+ * Every node has to start with an _Atomic uint64_t link field, which the
+ * arena uses to chain free nodes; the container can use it for its own
+ * links while the node is handed out. The arena bumps the tag of that field
+ * whenever the node is released, and keeps the tag otherwise.
+ */
+#define LFA_NULL 0xFFFFFFFFu			// index of no node
+#define LFA_MAX_SEGMENTS 32
+#define LFA_SEGMENT_SHIFT 10			// the first segment holds 1 << 10 nodes
+#define LFA_INDEX(TAGGED) ((uint32_t)(TAGGED))
+#define LFA_TAG(TAGGED) ((uint32_t)((TAGGED) >> 32))
+#define LFA_TAGGED(TAG, INDEX) (((uint64_t)(uint32_t)(TAG) << 32) | (uint32_t)(INDEX))
+
+typedef struct
+{
+	_Atomic(char*) segments[LFA_MAX_SEGMENTS];	// segment k holds 1024 << k nodes
+	size_t nodeSize;
+	_Atomic uint64_t freeList;	// tagged index of the first free node
+	_Atomic uint32_t unused;	// first index that was never handed out
+}LockFreeArena;
+
+/*
+ * Prepares an arena for nodes of nodeSize bytes, which must be at least
+ * sizeof(_Atomic uint64_t) and start with the link field.
+ */
+void LockFreeArena_init(LockFreeArena* arena, size_t nodeSize);
+/*
+ * Deallocates every segment of the arena. No other thread may be using it.
+ */
+void LockFreeArena_destroy(LockFreeArena* arena);
+/*
+ * Hands out the index of a node, or LFA_NULL on failure.
+ */
+uint32_t LockFreeArena_alloc(LockFreeArena* arena);
+/*
+ * Gives a node back to the arena. Its index may still be read by others.
+ */
+void LockFreeArena_release(LockFreeArena* arena, uint32_t index);
+
+/*
+ * Returns the segment holding index, and turns index into its position in
+ * that segment. Segment k starts at index 1024 * (2^k - 1).
+ */
+static inline unsigned int LockFreeArena_segment(uint32_t* index)
+{
+	uint32_t block = (*index >> LFA_SEGMENT_SHIFT) + 1;
+	unsigned int k = 0;
+#if defined(__GNUC__)
+	k = 31 - __builtin_clz(block);
+#else
+	while(block >> (k + 1)) k++;
+#endif
+	*index -= (uint32_t)(((1u << k) - 1) << LFA_SEGMENT_SHIFT);
+	return k;
+}
+/*
+ * Returns a pointer to the node at index, which must have been handed out.
+ */
+static inline void* LockFreeArena_get(LockFreeArena* arena, uint32_t index)
+{
+	unsigned int k = LockFreeArena_segment(&index);
+	return atomic_load_explicit(&arena->segments[k], memory_order_acquire) +
+			(size_t)index * arena->nodeSize;
+}
+
+#endif
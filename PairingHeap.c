@@ -0,0 +1,222 @@
+/*
+ * PairingHeap - A pairing heap of values of type E, which are generic and
+ * can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#include <stdlib.h>
+#include <assert.h>
+#include "PairingHeap.h"
+
+/*
+ * Returns 1 if val1 belongs above val2 in the heap, comparing with
+ * heap->compare if it's been implemented, or with '<' otherwise.
+ */
+static int PairingHeap_less(PairingHeap* heap, E val1, E val2)
+{
+	if(heap->compare) return heap->compare(val1, val2) < 0;
+	return val1 < val2;
+}
+/*
+ * Makes the larger of two roots the first child of the other and returns
+ * the new root, whose sibling and prev are left for the caller to set.
+ */
+static PHNode* PairingHeap_link(PairingHeap* heap, PHNode* a, PHNode* b)
+{
+	if(PairingHeap_less(heap, b->data, a->data))
+	{
+		PHNode* tmp = a;
+		a = b;
+		b = tmp;
+	}
+	b->sibling = a->child;
+	if(a->child != NULL) a->child->prev = b;
+	b->prev = a;
+	a->child = b;
+	return a;
+}
+/*
+ * Merges a list of siblings into one tree and returns its root: first
+ * linking them in pairs from left to right, then linking the pairs from
+ * right to left.
+ */
+static PHNode* PairingHeap_combine(PairingHeap* heap, PHNode* first)
+{
+	if(first == NULL) return NULL;
+	PHNode* pairs = NULL;	// chained through sibling, last pair first
+	while(first != NULL)
+	{
+		PHNode* a = first, *b = first->sibling;
+		if(b == NULL)
+		{
+			a->sibling = pairs;
+			pairs = a;
+			break;
+		}
+		first = b->sibling;
+		PHNode* pair = PairingHeap_link(heap, a, b);
+		pair->sibling = pairs;
+		pairs = pair;
+	}
+	PHNode* root = pairs;
+	pairs = pairs->sibling;
+	while(pairs != NULL)
+	{
+		PHNode* next = pairs->sibling;
+		root = PairingHeap_link(heap, root, pairs);
+		pairs = next;
+	}
+	root->sibling = NULL;
+	root->prev = NULL;
+	return root;
+}
+/*
+ * Cuts node and its subtree out of the tree. node must not be the root.
+ */
+static void PairingHeap_cut(PHNode* node)
+{
+	if(node->prev->child == node) node->prev->child = node->sibling;
+	else node->prev->sibling = node->sibling;
+	if(node->sibling != NULL) node->sibling->prev = node->prev;
+	node->sibling = NULL;
+	node->prev = NULL;
+}
+/*
+ * Links the tree at node with the root of the heap
+ */
+static void PairingHeap_meld(PairingHeap* heap, PHNode* node)
+{
+	if(heap->root == NULL) heap->root = node;
+	else heap->root = PairingHeap_link(heap, heap->root, node);
+	heap->root->sibling = NULL;
+	heap->root->prev = NULL;
+}
+/*
+ * Allocates an empty PairingHeap
+ */
+PairingHeap* PairingHeap_create()
+{
+	PairingHeap* heap = (PairingHeap*)malloc(sizeof(PairingHeap));
+	if(heap == NULL) return NULL;
+	heap->root = NULL;
+	heap->size = 0;
+	heap->compare = NULL;
+	return heap;
+}
+/*
+ * Deallocates a PairingHeap and every node in it. Children are rotated up
+ * into the sibling chain, so no stack is needed.
+ */
+void PairingHeap_free(PairingHeap* heap)
+{
+	if(heap == NULL) return;
+	PHNode* x = heap->root;
+	while(x != NULL)
+	{
+		PHNode* y;
+		if(x->child != NULL)
+		{
+			y = x->child;
+			x->child = y->sibling;
+			y->sibling = x;
+		}
+		else
+		{
+			y = x->sibling;
+			free(x);
+		}
+		x = y;
+	}
+	free(heap);
+}
+/*
+ * Adds an element. Returns its node, or NULL on failure.
+ */
+PHNode* PairingHeap_push(PairingHeap* heap, E value)
+{
+	assert(heap != NULL);
+	PHNode* node = (PHNode*)malloc(sizeof(PHNode));
+	if(node == NULL) return NULL;
+	node->data = value;
+	node->child = NULL;
+	node->sibling = NULL;
+	node->prev = NULL;
+	PairingHeap_meld(heap, node);
+	heap->size++;
+	return node;
+}
+/*
+ * Removes and returns the smallest element
+ */
+E PairingHeap_pop(PairingHeap* heap)
+{
+	assert(heap != NULL);
+	assert(heap->size > 0);
+	PHNode* root = heap->root;
+	E data = root->data;
+	heap->root = PairingHeap_combine(heap, root->child);
+	heap->size--;
+	free(root);
+	return data;
+}
+/*
+ * Returns the smallest element
+ */
+E PairingHeap_peek(PairingHeap* heap)
+{
+	assert(heap != NULL);
+	assert(heap->size > 0);
+	return heap->root->data;
+}
+/*
+ * Lowers the element at node to value. Nonzero if value is greater.
+ */
+int PairingHeap_decreaseKey(PairingHeap* heap, PHNode* node, E value)
+{
+	assert(heap != NULL && node != NULL);
+	if(PairingHeap_less(heap, node->data, value)) return 1;
+	node->data = value;
+	if(node == heap->root) return 0;
+	PairingHeap_cut(node);
+	PairingHeap_meld(heap, node);
+	return 0;
+}
+/*
+ * Removes the element at node and deallocates it. Nonzero on failure.
+ */
+int PairingHeap_remove(PairingHeap* heap, PHNode* node)
+{
+	if(heap == NULL || node == NULL || heap->size == 0) return 1;
+	if(node == heap->root)
+	{
+		PairingHeap_pop(heap);
+		return 0;
+	}
+	PairingHeap_cut(node);
+	PHNode* children = PairingHeap_combine(heap, node->child);
+	if(children != NULL) PairingHeap_meld(heap, children);
+	heap->size--;
+	free(node);
+	return 0;
+}
+/*
+ * Moves every node of src into dst, leaving src empty. Nonzero on failure.
+ */
+int PairingHeap_merge(PairingHeap* dst, PairingHeap* src)
+{
+	if(dst == NULL || src == NULL || dst == src) return 1;
+	if(dst->compare != src->compare) return 1;
+	if(src->root == NULL) return 0;
+	PairingHeap_meld(dst, src->root);
+	dst->size += src->size;
+	src->root = NULL;
+	src->size = 0;
+	return 0;
+}
+/*
+ * Returns the number of elements in the heap
+ */
+size_t PairingHeap_getSize(PairingHeap* heap)
+{
+	if(heap == NULL) return 0;
+	return heap->size;
+}
@@ -0,0 +1,95 @@
+/*
+ * PairingHeap - A heap of nodes that can be found again, for priorities
+ * that change
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+
+#include <stddef.h>
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing PairingHeap.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+/*
+ * A PHNode (PairingHeapNode) holds one element of a PairingHeap. Its first
+ * child is child, its next sibling is sibling, and prev is its previous
+ * sibling, or its parent if it's a first child. push hands out the node as
+ * a handle that stays valid until the element is popped or removed.
+ */
+typedef struct PHNode
+{
+	E data;
+	struct PHNode* child;
+	struct PHNode* sibling;
+	struct PHNode* prev;
+}PHNode;
+
+/*
+ * A PairingHeap is a tree whose root is its smallest element, each node
+ * no greater than its children. push, peek, merge and decreaseKey take
+ * O(1), and pop and remove O(log n) amortized, which makes it the heap to
+ * use when priorities go down while elements wait, as in Dijkstra's or
+ * Prim's algorithm. When they never change, a PriorityQueue is faster.
+ * compare works just like DoublyLinkedList.compare, and '<' and '>' are
+ * used if it hasn't been implemented.
+ */
+typedef struct
+{
+	PHNode* root;
+	size_t size;
+	int (*compare)(E val1, E val2);
+}PairingHeap;
+
+/*
+ * Allocates an empty PairingHeap. Returns NULL on failure.
+ */
+PairingHeap* PairingHeap_create();
+/*
+ * Deallocates a PairingHeap and every node in it.
+ */
+void PairingHeap_free(PairingHeap* heap);
+/*
+ * Adds an element in O(1). Returns its node, or NULL on failure.
+ */
+PHNode* PairingHeap_push(PairingHeap* heap, E value);
+/*
+ * Removes and returns the smallest element. The heap must not be empty.
+ */
+E PairingHeap_pop(PairingHeap* heap);
+/*
+ * Returns the smallest element. The heap must not be empty.
+ */
+E PairingHeap_peek(PairingHeap* heap);
+/*
+ * Lowers the element at node to value in O(1). Nonzero if value is
+ * greater than the element, in which case nothing changes.
+ */
+int PairingHeap_decreaseKey(PairingHeap* heap, PHNode* node, E value);
+/*
+ * Removes the element at node from the heap and deallocates the node.
+ * Nonzero on failure.
+ */
+int PairingHeap_remove(PairingHeap* heap, PHNode* node);
+/*
+ * Moves every node of src into dst in O(1), leaving src empty. Both heaps
+ * must compare the same way. Nonzero on failure.
+ */
+int PairingHeap_merge(PairingHeap* dst, PairingHeap* src);
+/*
+ * Returns the number of elements in the heap.
+ */
+size_t PairingHeap_getSize(PairingHeap* heap);
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ * PerfCounters - Hardware performance counters through perf_event_open,
+ * with every event unavailable where that can't be used.
+ * See PerfCounters.h.
+ */
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "PerfCounters.h"
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+const char* const PerfCounters_eventNames[PERF_EVENT_COUNT] =
+{
+	"cycles", "instructions", "L1d-misses", "LLC-misses", "branch-misses"
+};
+
+#ifdef __linux__
+/*
+ * Opens a counter of type and config for the calling thread, on any CPU,
+ * not counting the kernel, in the group led by leader (a new, disabled
+ * group if leader is -1). Returns the file descriptor, or -1.
+ */
+static int PerfCounters_open(unsigned int type, unsigned long long config, int leader)
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.disabled = leader < 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+			PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+/*
+ * Reads the group into values: the number of events, the time it's been
+ * enabled, the time it's been running, then a count per event.
+ * Nonzero on failure.
+ */
+static int PerfCounters_read(PerfCounters* pc, unsigned long long* values)
+{
+	size_t size = (3 + pc->available) * sizeof(unsigned long long);
+	return read(pc->leader, values, size) != (ssize_t)size;
+}
+/*
+ * Returns nonzero if the group gets onto the hardware at all, which it
+ * doesn't once it holds more events than there are counters.
+ */
+static int PerfCounters_fits(PerfCounters* pc)
+{
+	unsigned long long values[3 + PERF_EVENT_COUNT];
+	volatile int spin;
+	ioctl(pc->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	for(spin = 0; spin < 10000; spin++);
+	ioctl(pc->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	return !PerfCounters_read(pc, values) && values[2] > 0;
+}
+#endif
+/*
+ * Opens every event it can, in one group. Returns NULL on failure.
+ */
+PerfCounters* PerfCounters_create()
+{
+	PerfCounters* pc = (PerfCounters*)malloc(sizeof(PerfCounters));
+	if(pc == NULL) return NULL;
+	int i;
+	for(i = 0; i < PERF_EVENT_COUNT; i++)
+	{
+		pc->fds[i] = -1;
+		pc->slots[i] = -1;
+	}
+	pc->leader = -1;
+	pc->available = 0;
+	pc->enabled = 0;
+	pc->running = 0;
+#ifdef __linux__
+	static const unsigned int types[PERF_EVENT_COUNT] =
+	{
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+	};
+	static const unsigned long long configs[PERF_EVENT_COUNT] =
+	{
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+				(PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES
+	};
+	for(i = 0; i < PERF_EVENT_COUNT; i++)
+	{
+		int fd = PerfCounters_open(types[i], configs[i], pc->leader);
+		if(fd < 0) continue;
+		if(pc->leader < 0) pc->leader = fd;
+		pc->fds[i] = fd;
+		pc->slots[i] = pc->available++;
+		if(PerfCounters_fits(pc)) continue;
+		// a member that doesn't fit can only be the last one opened
+		close(fd);
+		if(fd == pc->leader) pc->leader = -1;
+		pc->fds[i] = -1;
+		pc->slots[i] = -1;
+		pc->available--;
+	}
+#endif
+	return pc;
+}
+/*
+ * Closes the counters and deallocates the PerfCounters.
+ */
+void PerfCounters_free(PerfCounters* pc)
+{
+	if(pc == NULL) return;
+#ifdef __linux__
+	int i;
+	// members first, the leader last
+	for(i = 0; i < PERF_EVENT_COUNT; i++)
+		if(pc->fds[i] >= 0 && pc->fds[i] != pc->leader) close(pc->fds[i]);
+	if(pc->leader >= 0) close(pc->leader);
+#endif
+	free(pc);
+}
+/*
+ * Returns nonzero if event is being counted.
+ */
+int PerfCounters_isAvailable(PerfCounters* pc, PerfEvent event)
+{
+	assert(pc != NULL && event < PERF_EVENT_COUNT);
+	return pc->fds[event] >= 0;
+}
+/*
+ * Notes how long the group has been enabled and running so far, zeroes its
+ * counts and starts counting.
+ */
+void PerfCounters_start(PerfCounters* pc)
+{
+	assert(pc != NULL);
+#ifdef __linux__
+	if(pc->leader < 0) return;
+	unsigned long long values[3 + PERF_EVENT_COUNT];
+	if(PerfCounters_read(pc, values)) values[1] = values[2] = 0;
+	pc->enabled = values[1];
+	pc->running = values[2];
+	ioctl(pc->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(pc->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+/*
+ * Stops counting and adds the counts, scaled up for the part of the
+ * interval the group wasn't on the hardware, to counts.
+ */
+void PerfCounters_stop(PerfCounters* pc, double* counts)
+{
+	assert(pc != NULL && counts != NULL);
+#ifdef __linux__
+	if(pc->leader < 0) return;
+	ioctl(pc->leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	unsigned long long values[3 + PERF_EVENT_COUNT];
+	if(PerfCounters_read(pc, values)) return;
+	// RESET only zeroes the counts, the times keep adding up since the open
+	unsigned long long enabled = values[1] - pc->enabled;
+	unsigned long long running = values[2] - pc->running;
+	if(running == 0) return;
+	int i;
+	for(i = 0; i < PERF_EVENT_COUNT; i++)
+		if(pc->slots[i] >= 0)
+			counts[i] += (double)values[3 + pc->slots[i]] * enabled / running;
+#else
+	(void)counts;
+#endif
+}
@@ -0,0 +1,70 @@
+/*
+ * PerfCounters - Hardware performance counters around a stretch of code
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+/*
+ * The events a PerfCounters counts.
+ */
+typedef enum
+{
+	PERF_CYCLES,
+	PERF_INSTRUCTIONS,
+	PERF_L1D_MISSES,		// L1 data cache read misses
+	PERF_LLC_MISSES,		// last level cache misses
+	PERF_BRANCH_MISSES,
+	PERF_EVENT_COUNT
+}PerfEvent;
+
+extern const char* const PerfCounters_eventNames[PERF_EVENT_COUNT];
+
+/*
+ * A PerfCounters counts PerfEvents of the calling thread, in user space,
+ * through Linux's perf_event_open. The events are opened as one group led
+ * by the first of them that opens, so the kernel always puts them on the
+ * hardware together and every ratio between them covers the same stretch
+ * of time. Every event that can't be opened (no such hardware counter,
+ * perf_event_paranoid too strict, not Linux...) or that would keep the
+ * group from fitting on the hardware just stays unavailable, and reads as
+ * 0, so the code around it runs the same either way. When the kernel has
+ * to share the hardware with other groups, counts are scaled up by how
+ * long the group was enabled over how long it actually ran, both measured
+ * between PerfCounters_start and PerfCounters_stop.
+ */
+typedef struct
+{
+	int fds[PERF_EVENT_COUNT];	// -1 for unavailable events
+	int slots[PERF_EVENT_COUNT];	// where each event comes in a group read
+	int leader;					// fd that leads the group, -1 for none
+	int available;				// number of available events
+	unsigned long long enabled;	// time the group had been enabled at start
+	unsigned long long running;	// time the group had been running at start
+}PerfCounters;
+
+/*
+ * Opens every event it can. Returns NULL on failure, but a PerfCounters
+ * without any available events is not a failure.
+ */
+PerfCounters* PerfCounters_create();
+/*
+ * Closes the counters and deallocates the PerfCounters.
+ */
+void PerfCounters_free(PerfCounters* pc);
+/*
+ * Returns nonzero if event is being counted.
+ */
+int PerfCounters_isAvailable(PerfCounters* pc, PerfEvent event);
+/*
+ * Zeroes the counters and starts counting.
+ */
+void PerfCounters_start(PerfCounters* pc);
+/*
+ * Stops counting and adds what was counted since PerfCounters_start to
+ * counts, which has room for PERF_EVENT_COUNT values.
+ */
+void PerfCounters_stop(PerfCounters* pc, double* counts);
+
+#endif
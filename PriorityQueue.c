@@ -0,0 +1,162 @@
+/*
+ * PriorityQueue - A d-ary min-heap of values of type E, which are generic
+ * and can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "PriorityQueue.h"
+
+/*
+ * Returns 1 if val1 belongs above val2 in the heap, comparing with
+ * pq->compare if it's been implemented, or with '<' otherwise.
+ */
+static int PriorityQueue_less(PriorityQueue* pq, E val1, E val2)
+{
+	if(pq->compare) return pq->compare(val1, val2) < 0;
+	return val1 < val2;
+}
+/*
+ * Moves the element at i up until its parent isn't greater than it.
+ */
+static void PriorityQueue_siftUp(PriorityQueue* pq, size_t i)
+{
+	E value = pq->values[i];
+	while(i > 0)
+	{
+		size_t parent = (i - 1) / PRIORITYQUEUE_ARITY;
+		if(!PriorityQueue_less(pq, value, pq->values[parent])) break;
+		pq->values[i] = pq->values[parent];
+		i = parent;
+	}
+	pq->values[i] = value;
+}
+/*
+ * Moves the element at i down until none of its children is smaller.
+ */
+static void PriorityQueue_siftDown(PriorityQueue* pq, size_t i)
+{
+	E value = pq->values[i];
+	for(;;)
+	{
+		size_t first = i * PRIORITYQUEUE_ARITY + 1;
+		if(first >= pq->size) break;
+		size_t last = first + PRIORITYQUEUE_ARITY;
+		if(last > pq->size) last = pq->size;
+		size_t smallest = first, child;
+		for(child = first + 1; child < last; child++)
+			if(PriorityQueue_less(pq, pq->values[child], pq->values[smallest]))
+				smallest = child;
+		if(!PriorityQueue_less(pq, pq->values[smallest], value)) break;
+		pq->values[i] = pq->values[smallest];
+		i = smallest;
+	}
+	pq->values[i] = value;
+}
+/*
+ * Allocates an empty PriorityQueue with room for capacity elements
+ */
+PriorityQueue* PriorityQueue_create(size_t capacity)
+{
+	PriorityQueue* pq = (PriorityQueue*)malloc(sizeof(PriorityQueue));
+	if(pq == NULL) return NULL;
+	pq->values = NULL;
+	pq->size = 0;
+	pq->capacity = 0;
+	pq->compare = NULL;
+	if(PriorityQueue_reserve(pq, capacity ? capacity : PRIORITYQUEUE_SIZE))
+	{
+		free(pq);
+		return NULL;
+	}
+	return pq;
+}
+/*
+ * Deallocates a PriorityQueue
+ */
+void PriorityQueue_free(PriorityQueue* pq)
+{
+	if(pq == NULL) return;
+	free(pq->values);
+	free(pq);
+}
+/*
+ * Makes room for capacity elements. Nonzero on failure.
+ */
+int PriorityQueue_reserve(PriorityQueue* pq, size_t capacity)
+{
+	if(pq == NULL) return 1;
+	if(capacity <= pq->capacity) return 0;
+	if(capacity > (size_t)-1 / sizeof(E)) return 1;
+	E* values = (E*)realloc(pq->values, capacity * sizeof(E));
+	if(values == NULL) return 1;
+	pq->values = values;
+	pq->capacity = capacity;
+	return 0;
+}
+/*
+ * Adds an element, doubling the array when it's full. Nonzero on failure.
+ */
+int PriorityQueue_push(PriorityQueue* pq, E value)
+{
+	assert(pq != NULL);
+	if(pq->size == pq->capacity && PriorityQueue_reserve(pq, pq->capacity * 2))
+		return 1;
+	pq->values[pq->size] = value;
+	PriorityQueue_siftUp(pq, pq->size++);
+	return 0;
+}
+/*
+ * Adds count elements at once. Nonzero on failure.
+ */
+int PriorityQueue_pushArray(PriorityQueue* pq, const E* values, size_t count)
+{
+	assert(pq != NULL);
+	if(values == NULL && count > 0) return 1;
+	if(count == 0) return 0;
+	if(pq->size + count > pq->capacity)
+	{
+		size_t capacity = pq->capacity;
+		while(capacity < pq->size + count)
+			capacity *= 2;
+		if(PriorityQueue_reserve(pq, capacity)) return 1;
+	}
+	memcpy(pq->values + pq->size, values, count * sizeof(E));
+	pq->size += count;
+	if(pq->size == 1) return 0;
+	// sift down every element that has children, the deepest first
+	size_t i = (pq->size - 2) / PRIORITYQUEUE_ARITY + 1;
+	while(i-- > 0)
+		PriorityQueue_siftDown(pq, i);
+	return 0;
+}
+/*
+ * Removes and returns the smallest element
+ */
+E PriorityQueue_pop(PriorityQueue* pq)
+{
+	assert(pq != NULL);
+	assert(pq->size > 0);
+	E top = pq->values[0];
+	pq->values[0] = pq->values[--pq->size];
+	if(pq->size > 0) PriorityQueue_siftDown(pq, 0);
+	return top;
+}
+/*
+ * Returns the smallest element
+ */
+E PriorityQueue_peek(PriorityQueue* pq)
+{
+	assert(pq != NULL);
+	assert(pq->size > 0);
+	return pq->values[0];
+}
+/*
+ * Returns the number of elements in the queue
+ */
+size_t PriorityQueue_getSize(PriorityQueue* pq)
+{
+	if(pq == NULL) return 0;
+	return pq->size;
+}
@@ -0,0 +1,87 @@
+/*
+ * PriorityQueue - A d-ary heap that always knows its smallest element
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <stddef.h>
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing PriorityQueue.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+#ifndef PRIORITYQUEUE_ARITY
+#define PRIORITYQUEUE_ARITY 4	// children per heap node
+#endif
+#define PRIORITYQUEUE_SIZE 16	// Default initial capacity
+
+/*
+ * A PriorityQueue is what an auto-sorted DoublyLinkedList is when all it's
+ * used for is sortedInsert and popHead: an array kept in heap order, each
+ * element no greater than its PRIORITYQUEUE_ARITY children, so push and pop
+ * take O(log n) and peek O(1), with no node per element. A 4-ary heap is
+ * half as deep as a binary one and its children share a cache line or two,
+ * which makes up for the extra compares on the way down.
+ * compare works just like DoublyLinkedList.compare: if it's been
+ * implemented it returns 0 if val1 == val2, >0 if val1 > val2 and <0 if
+ * val1 < val2, and otherwise '<' and '>' are used. Equal elements come out
+ * in no particular order.
+ */
+typedef struct
+{
+	E* values;		// the heap, smallest first
+	size_t size;
+	size_t capacity;
+	int (*compare)(E val1, E val2);
+}PriorityQueue;
+
+/*
+ * Allocates an empty PriorityQueue with room for capacity elements
+ * (PRIORITYQUEUE_SIZE if capacity is 0). Returns NULL on failure.
+ */
+PriorityQueue* PriorityQueue_create(size_t capacity);
+/*
+ * Deallocates a PriorityQueue.
+ */
+void PriorityQueue_free(PriorityQueue* pq);
+/*
+ * Makes room for capacity elements in total. Nonzero on failure.
+ */
+int PriorityQueue_reserve(PriorityQueue* pq, size_t capacity);
+/*
+ * Adds an element in O(log n). Nonzero on failure.
+ */
+int PriorityQueue_push(PriorityQueue* pq, E value);
+/*
+ * Adds count elements at once and restores heap order in a single O(n)
+ * pass, which beats pushing them one by one when count is large next to
+ * the size of the queue. Nonzero on failure, in which case the queue is
+ * left as it was.
+ */
+int PriorityQueue_pushArray(PriorityQueue* pq, const E* values, size_t count);
+/*
+ * Removes and returns the smallest element, in O(log n). The queue must
+ * not be empty.
+ */
+E PriorityQueue_pop(PriorityQueue* pq);
+/*
+ * Returns the smallest element. The queue must not be empty.
+ */
+E PriorityQueue_peek(PriorityQueue* pq);
+/*
+ * Returns the number of elements in the queue.
+ */
+size_t PriorityQueue_getSize(PriorityQueue* pq);
+
+#endif
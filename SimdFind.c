@@ -0,0 +1,269 @@
+/*
+ * SimdFind - SSE2 and AVX2 kernels for finding a value in an array, chosen
+ * at runtime, with a plain loop for everything else. See SimdFind.h.
+ */
+#include "SimdFind.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMDFIND_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Finishes a search from index i one element at a time
+ */
+#define SIMDFIND_SCALAR(DATA, I, COUNT, VALUE)							\
+	for(; I < COUNT; I++)												\
+		if(DATA[I] == VALUE) return I;									\
+	return COUNT
+
+/*
+ * Returns the index of the lowest set bit of mask, which isn't 0
+ */
+static inline unsigned int SimdFind_firstBit(unsigned int mask)
+{
+#if defined(__GNUC__)
+	return (unsigned int)__builtin_ctz(mask);
+#else
+	unsigned int i = 0;
+	while(!(mask & 1u)) { mask >>= 1; i++; }
+	return i;
+#endif
+}
+
+#ifdef SIMDFIND_X86
+/*
+ * Looks at 16 doubles per iteration, 4 per compare
+ */
+__attribute__((target("avx2")))
+static size_t SimdFind_doubleAVX2(const double* data, size_t count, double value)
+{
+	__m256d key = _mm256_set1_pd(value);
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16)
+	{
+		__m256d a = _mm256_cmp_pd(_mm256_loadu_pd(data + i), key, _CMP_EQ_OQ);
+		__m256d b = _mm256_cmp_pd(_mm256_loadu_pd(data + i + 4), key, _CMP_EQ_OQ);
+		__m256d c = _mm256_cmp_pd(_mm256_loadu_pd(data + i + 8), key, _CMP_EQ_OQ);
+		__m256d d = _mm256_cmp_pd(_mm256_loadu_pd(data + i + 12), key, _CMP_EQ_OQ);
+		unsigned int mask = (unsigned int)_mm256_movemask_pd(a) |
+				(unsigned int)_mm256_movemask_pd(b) << 4 |
+				(unsigned int)_mm256_movemask_pd(c) << 8 |
+				(unsigned int)_mm256_movemask_pd(d) << 12;
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	for(; i + 4 <= count; i += 4)
+	{
+		unsigned int mask = (unsigned int)_mm256_movemask_pd(
+				_mm256_cmp_pd(_mm256_loadu_pd(data + i), key, _CMP_EQ_OQ));
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 8 doubles per iteration, 2 per compare
+ */
+__attribute__((target("sse2")))
+static size_t SimdFind_doubleSSE2(const double* data, size_t count, double value)
+{
+	__m128d key = _mm_set1_pd(value);
+	size_t i = 0;
+	for(; i + 8 <= count; i += 8)
+	{
+		__m128d a = _mm_cmpeq_pd(_mm_loadu_pd(data + i), key);
+		__m128d b = _mm_cmpeq_pd(_mm_loadu_pd(data + i + 2), key);
+		__m128d c = _mm_cmpeq_pd(_mm_loadu_pd(data + i + 4), key);
+		__m128d d = _mm_cmpeq_pd(_mm_loadu_pd(data + i + 6), key);
+		unsigned int mask = (unsigned int)_mm_movemask_pd(a) |
+				(unsigned int)_mm_movemask_pd(b) << 2 |
+				(unsigned int)_mm_movemask_pd(c) << 4 |
+				(unsigned int)_mm_movemask_pd(d) << 6;
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 32 floats per iteration, 8 per compare
+ */
+__attribute__((target("avx2")))
+static size_t SimdFind_floatAVX2(const float* data, size_t count, float value)
+{
+	__m256 key = _mm256_set1_ps(value);
+	size_t i = 0;
+	for(; i + 32 <= count; i += 32)
+	{
+		__m256 a = _mm256_cmp_ps(_mm256_loadu_ps(data + i), key, _CMP_EQ_OQ);
+		__m256 b = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 8), key, _CMP_EQ_OQ);
+		__m256 c = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 16), key, _CMP_EQ_OQ);
+		__m256 d = _mm256_cmp_ps(_mm256_loadu_ps(data + i + 24), key, _CMP_EQ_OQ);
+		unsigned int mask = (unsigned int)_mm256_movemask_ps(a) |
+				(unsigned int)_mm256_movemask_ps(b) << 8 |
+				(unsigned int)_mm256_movemask_ps(c) << 16 |
+				(unsigned int)_mm256_movemask_ps(d) << 24;
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	for(; i + 8 <= count; i += 8)
+	{
+		unsigned int mask = (unsigned int)_mm256_movemask_ps(
+				_mm256_cmp_ps(_mm256_loadu_ps(data + i), key, _CMP_EQ_OQ));
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 16 floats per iteration, 4 per compare
+ */
+__attribute__((target("sse2")))
+static size_t SimdFind_floatSSE2(const float* data, size_t count, float value)
+{
+	__m128 key = _mm_set1_ps(value);
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16)
+	{
+		__m128 a = _mm_cmpeq_ps(_mm_loadu_ps(data + i), key);
+		__m128 b = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 4), key);
+		__m128 c = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 8), key);
+		__m128 d = _mm_cmpeq_ps(_mm_loadu_ps(data + i + 12), key);
+		unsigned int mask = (unsigned int)_mm_movemask_ps(a) |
+				(unsigned int)_mm_movemask_ps(b) << 4 |
+				(unsigned int)_mm_movemask_ps(c) << 8 |
+				(unsigned int)_mm_movemask_ps(d) << 12;
+		if(mask) return i + SimdFind_firstBit(mask);
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 32 int32s per iteration, 8 per compare. movemask works on bytes
+ * here, so every match sets 4 bits of the mask.
+ */
+__attribute__((target("avx2")))
+static size_t SimdFind_int32AVX2(const int32_t* data, size_t count, int32_t value)
+{
+	__m256i key = _mm256_set1_epi32(value);
+	size_t i = 0;
+	for(; i + 32 <= count; i += 32)
+	{
+		__m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i)), key);
+		__m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 8)), key);
+		__m256i c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 16)), key);
+		__m256i d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(data + i + 24)), key);
+		__m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if(_mm256_movemask_epi8(any))
+			break;	// the loop below pins it down
+	}
+	for(; i + 8 <= count; i += 8)
+	{
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi32(
+				_mm256_loadu_si256((const __m256i*)(data + i)), key));
+		if(mask) return i + SimdFind_firstBit(mask) / 4;
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 16 int32s per iteration, 4 per compare
+ */
+__attribute__((target("sse2")))
+static size_t SimdFind_int32SSE2(const int32_t* data, size_t count, int32_t value)
+{
+	__m128i key = _mm_set1_epi32(value);
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16)
+	{
+		__m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i)), key);
+		__m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 4)), key);
+		__m128i c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 8)), key);
+		__m128i d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(data + i + 12)), key);
+		__m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+		if(_mm_movemask_epi8(any))
+			break;
+	}
+	for(; i + 4 <= count; i += 4)
+	{
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(
+				_mm_loadu_si128((const __m128i*)(data + i)), key));
+		if(mask) return i + SimdFind_firstBit(mask) / 4;
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Looks at 16 int64s per iteration, 4 per compare. SSE2 has no 64-bit
+ * compare, so int64s don't get an SSE2 kernel.
+ */
+__attribute__((target("avx2")))
+static size_t SimdFind_int64AVX2(const int64_t* data, size_t count, int64_t value)
+{
+	__m256i key = _mm256_set1_epi64x(value);
+	size_t i = 0;
+	for(; i + 16 <= count; i += 16)
+	{
+		__m256i a = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i)), key);
+		__m256i b = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i + 4)), key);
+		__m256i c = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i + 8)), key);
+		__m256i d = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(data + i + 12)), key);
+		__m256i any = _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d));
+		if(_mm256_movemask_epi8(any))
+			break;
+	}
+	for(; i + 4 <= count; i += 4)
+	{
+		unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi64(
+				_mm256_loadu_si256((const __m256i*)(data + i)), key));
+		if(mask) return i + SimdFind_firstBit(mask) / 8;
+	}
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+
+/*
+ * Whether this CPU runs AVX2, and SSE2 (always, on x86-64)
+ */
+#define SIMDFIND_HAS_AVX2() __builtin_cpu_supports("avx2")
+#define SIMDFIND_HAS_SSE2() __builtin_cpu_supports("sse2")
+#endif
+
+/*
+ * Returns the index of the first double equal to value, or count
+ */
+size_t SimdFind_double(const double* data, size_t count, double value)
+{
+	size_t i = 0;
+#ifdef SIMDFIND_X86
+	if(SIMDFIND_HAS_AVX2()) return SimdFind_doubleAVX2(data, count, value);
+	if(SIMDFIND_HAS_SSE2()) return SimdFind_doubleSSE2(data, count, value);
+#endif
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Returns the index of the first float equal to value, or count
+ */
+size_t SimdFind_float(const float* data, size_t count, float value)
+{
+	size_t i = 0;
+#ifdef SIMDFIND_X86
+	if(SIMDFIND_HAS_AVX2()) return SimdFind_floatAVX2(data, count, value);
+	if(SIMDFIND_HAS_SSE2()) return SimdFind_floatSSE2(data, count, value);
+#endif
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Returns the index of the first int32 equal to value, or count
+ */
+size_t SimdFind_int32(const int32_t* data, size_t count, int32_t value)
+{
+	size_t i = 0;
+#ifdef SIMDFIND_X86
+	if(SIMDFIND_HAS_AVX2()) return SimdFind_int32AVX2(data, count, value);
+	if(SIMDFIND_HAS_SSE2()) return SimdFind_int32SSE2(data, count, value);
+#endif
+	SIMDFIND_SCALAR(data, i, count, value);
+}
+/*
+ * Returns the index of the first int64 equal to value, or count
+ */
+size_t SimdFind_int64(const int64_t* data, size_t count, int64_t value)
+{
+	size_t i = 0;
+#ifdef SIMDFIND_X86
+	if(SIMDFIND_HAS_AVX2()) return SimdFind_int64AVX2(data, count, value);
+#endif
+	SIMDFIND_SCALAR(data, i, count, value);
+}
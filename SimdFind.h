@@ -0,0 +1,39 @@
+/*
+ * SimdFind - Vectorized linear search over contiguous arrays of numbers
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef SIMDFIND_H
+#define SIMDFIND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Each SimdFind function returns the index of the first element of data
+ * equal to value, or count if there's none. Equal means ==, so NaN is never
+ * found and 0 finds -0.
+ * On x86 the kernel is picked at runtime: AVX2 compares 4 to 8 values per
+ * instruction and runs 4 vectors per iteration, SSE2 compares 2 to 4, and
+ * anything else gets a plain loop.
+ */
+size_t SimdFind_double(const double* data, size_t count, double value);
+size_t SimdFind_float(const float* data, size_t count, float value);
+size_t SimdFind_int32(const int32_t* data, size_t count, int32_t value);
+size_t SimdFind_int64(const int64_t* data, size_t count, int64_t value);
+
+/*
+ * Picks the SimdFind function for the type DATA points to, or FALLBACK (a
+ * function with the same signature) for any other type.
+ * Usage:
+ * size_t i = SIMD_FIND(node->data, node->count, value, scanArray);
+ */
+#define SIMD_FIND(DATA, COUNT, VALUE, FALLBACK)							\
+	_Generic((DATA),													\
+		double*: SimdFind_double, const double*: SimdFind_double,		\
+		float*: SimdFind_float, const float*: SimdFind_float,			\
+		int32_t*: SimdFind_int32, const int32_t*: SimdFind_int32,		\
+		int64_t*: SimdFind_int64, const int64_t*: SimdFind_int64,		\
+		default: FALLBACK)((DATA), (COUNT), (VALUE))
+
+#endif
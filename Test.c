@@ -1,10 +1,123 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #define GENERICS int
 #include "DoublyLinkedList.h"
 #include "CircularDoublyLinkedList.h"
 
+/*
+ * Compares dll with model, the array of what it should hold, through
+ * getAt, rankOf and a traversal. Returns the number of mismatches.
+ */
+static int checkPositions(DoublyLinkedList* dll, const E* model, size_t size)
+{
+	int errors = 0;
+	size_t i = 0;
+	DLLNode* handle;
+	if(dll->size != size) errors++;
+	DLL_TRAVERSAL(dll, handle)
+	{
+		if(i >= size || handle->data != model[i]) errors++;
+		if(DoublyLinkedList_getAt(dll, i) != handle) errors++;
+		if(DoublyLinkedList_rankOf(handle) != i) errors++;
+		i++;
+	}
+	if(i != size || DoublyLinkedList_getAt(dll, size) != NULL) errors++;
+	return errors;
+}
+/*
+ * Compares two E's for qsort.
+ */
+static int compareE(const void* a, const void* b)
+{
+	E x = *(const E*)a, y = *(const E*)b;
+	return (x > y) - (x < y);
+}
+/*
+ * Runs a random mix of pushes, pops, positional inserts and removes, moves
+ * to either end and sorts on a list, with (or without) a rank index that
+ * also gets dropped and rebuilt now and then, checking it against an array
+ * after every step. Returns the number of mismatches.
+ */
+static int testPositions(int rankIndex, int steps)
+{
+	DoublyLinkedList* dll = DoublyLinkedList_create();
+	E* model = (E*)malloc(steps * sizeof(E));
+	size_t size = 0, index;
+	int errors = 0, step;
+	if(rankIndex && DoublyLinkedList_enableRankIndex(dll)) errors++;
+	for(step = 0; step < steps; step++)
+	{
+		E value = (E)step;
+		DLLNode* node;
+		int op = rand() % 10;
+		if(size == 0 && op >= 2 && op != 4) op = rand() % 2;
+		index = size ? (size_t)rand() % size : 0;
+		switch(op)
+		{
+		case 0:
+			if(DoublyLinkedList_pushHead(dll, value)) errors++;
+			memmove(model + 1, model, size * sizeof(E));
+			model[0] = value;
+			size++;
+			break;
+		case 1:
+			if(DoublyLinkedList_pushTail(dll, value)) errors++;
+			model[size++] = value;
+			break;
+		case 2:
+			if(DoublyLinkedList_popHead(dll) != model[0]) errors++;
+			memmove(model, model + 1, --size * sizeof(E));
+			break;
+		case 3:
+			if(DoublyLinkedList_popTail(dll) != model[--size]) errors++;
+			break;
+		case 4:
+			index = (size_t)rand() % (size + 1);
+			if(DoublyLinkedList_insertAt(dll, index, value)) errors++;
+			memmove(model + index + 1, model + index, (size - index) * sizeof(E));
+			model[index] = value;
+			size++;
+			break;
+		case 5:
+			if(DoublyLinkedList_removeAt(dll, index)) errors++;
+			memmove(model + index, model + index + 1, (--size - index) * sizeof(E));
+			break;
+		case 6:
+			node = DoublyLinkedList_getAt(dll, index);
+			if(node == NULL || DoublyLinkedList_moveToHead(node)) errors++;
+			value = model[index];
+			memmove(model + 1, model, index * sizeof(E));
+			model[0] = value;
+			break;
+		case 7:
+			node = DoublyLinkedList_getAt(dll, index);
+			if(node == NULL || DoublyLinkedList_moveToTail(node)) errors++;
+			value = model[index];
+			memmove(model + index, model + index + 1, (size - index - 1) * sizeof(E));
+			model[size - 1] = value;
+			break;
+		case 8:
+			if(rand() % 8) break;
+			if(DoublyLinkedList_sort(dll)) errors++;
+			qsort(model, size, sizeof(E), compareE);
+			// keep mixing in operations that need an unsorted list
+			dll->sorted = 0;
+			break;
+		case 9:
+			if(!rankIndex || rand() % 8) break;
+			DoublyLinkedList_disableRankIndex(dll);
+			if(DoublyLinkedList_enableRankIndex(dll)) errors++;
+			break;
+		}
+		errors += checkPositions(dll, model, size);
+	}
+	DoublyLinkedList_free(dll);
+	free(model);
+	return errors;
+}
+
 /*
  * Tests all functions of DoublyLinkedList and CircularDoublyLinkedList
  */
@@ -90,11 +203,18 @@ int main()
 	printf("Freeing List, again...\n");
 	fflush(stdout);
 	DoublyLinkedList_free(dll);
+	printf("Checking positions without and with a rank index...\n");
+	fflush(stdout);
+	for(i=0; i<2; i++)
+	{
+		int errors = testPositions(i, 2000);
+		if(errors) printf("error: %d position mismatches (rank index %s)\n", errors, i ? "on" : "off");
+	}
 	printf("Done!\n");
 	// Test all functions of CircularDoublyLinkedList
 	CircularDoublyLinkedList* cdll = (CircularDoublyLinkedList*)malloc(sizeof(CircularDoublyLinkedList));
 	CircularDoublyLinkedList_initialize(cdll, (E)1);
-	int i = 2;
+	i = 2;
 	while(i <= 11)
 	{
 		CircularDoublyLinkedList_addEntry(cdll, (E)i);
@@ -120,7 +240,7 @@ int main()
 		ptr = CircularDoublyLinkedList_getNext(ptr);
 
 	}
-	if(ptr.next != NULL || !CircularDoublyLinkedList_equals(CircularDoublyLinkedList_getHandle(cdll), ptr))
+	if(!CircularDoublyLinkedList_equals(CircularDoublyLinkedList_getHandle(cdll), ptr))
 		printf("Premature loop termination.\n");
 	printf("\n");
 	tmp = -1;
@@ -140,7 +260,7 @@ int main()
 		ptr = CircularDoublyLinkedList_getPrev(ptr);
 
 	}
-	if(ptr.prev != NULL || !CircularDoublyLinkedList_equals(CircularDoublyLinkedList_getHandle(cdll), ptr))
+	if(!CircularDoublyLinkedList_equals(CircularDoublyLinkedList_getHandle(cdll), ptr))
 		printf("Premature loop termination.\n");
 	printf("\n");
 	printf("Head value: %d\n", (int)CircularDoublyLinkedList_getData(CircularDoublyLinkedList_getHandle(cdll)));
@@ -0,0 +1,127 @@
+/*
+ * ThreadPool - A reusable set of POSIX worker threads that run batches of
+ * indexed tasks. See ThreadPool.h.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <unistd.h>
+#include "ThreadPool.h"
+
+/*
+ * Runs tasks of the current batch until there are none left to hand out.
+ * Called and returns with pool->lock held.
+ */
+static void ThreadPool_work(ThreadPool* pool)
+{
+	while(pool->next < pool->count)
+	{
+		int index = pool->next++;
+		ThreadPoolTask task = pool->task;
+		void* arg = pool->arg;
+		pthread_mutex_unlock(&pool->lock);
+		task(arg, index);
+		pthread_mutex_lock(&pool->lock);
+		if(++pool->finished == pool->count)
+			pthread_cond_signal(&pool->done);
+	}
+}
+/*
+ * Thread entry point of a worker, which sleeps until a batch is started.
+ */
+static void* ThreadPool_worker(void* arg)
+{
+	ThreadPool* pool = (ThreadPool*)arg;
+	pthread_mutex_lock(&pool->lock);
+	unsigned long seen = pool->batch;
+	for(;;)
+	{
+		while(!pool->stopping && pool->batch == seen)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		if(pool->stopping) break;
+		seen = pool->batch;
+		ThreadPool_work(pool);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+/*
+ * Allocates a ThreadPool running batches on threads threads in all
+ */
+ThreadPool* ThreadPool_create(int threads)
+{
+	if(threads <= 0)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = online > 0 ? (int)online : 1;
+	}
+	ThreadPool* pool = (ThreadPool*)malloc(sizeof(ThreadPool));
+	if(pool == NULL) return NULL;
+	pool->workers = (pthread_t*)malloc(threads * sizeof(pthread_t));
+	if(pool->workers == NULL)
+	{
+		free(pool);
+		return NULL;
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	pool->task = NULL;
+	pool->arg = NULL;
+	pool->count = 0;
+	pool->next = 0;
+	pool->finished = 0;
+	pool->batch = 0;
+	pool->stopping = 0;
+	// the calling thread is thread 0, so it needs no worker
+	for(pool->threads = 1; pool->threads < threads; pool->threads++)
+	{
+		if(pthread_create(&pool->workers[pool->threads], NULL, ThreadPool_worker, pool))
+			break;
+	}
+	return pool;
+}
+/*
+ * Stops the workers and deallocates the pool
+ */
+void ThreadPool_free(ThreadPool* pool)
+{
+	if(pool == NULL) return;
+	pthread_mutex_lock(&pool->lock);
+	pool->stopping = 1;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	int i;
+	for(i = 1; i < pool->threads; i++)
+		pthread_join(pool->workers[i], NULL);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->wake);
+	pthread_cond_destroy(&pool->done);
+	free(pool->workers);
+	free(pool);
+}
+/*
+ * Runs task(arg, i) for every i below count and waits for all of them
+ */
+void ThreadPool_run(ThreadPool* pool, ThreadPoolTask task, void* arg, int count)
+{
+	if(count <= 0) return;
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->arg = arg;
+	pool->count = count;
+	pool->next = 0;
+	pool->finished = 0;
+	pool->batch++;
+	if(pool->threads > 1) pthread_cond_broadcast(&pool->wake);
+	ThreadPool_work(pool);
+	while(pool->finished < pool->count)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+/*
+ * Returns the number of threads a batch runs on
+ */
+int ThreadPool_getThreads(ThreadPool* pool)
+{
+	return pool != NULL ? pool->threads : 1;
+}
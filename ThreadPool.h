@@ -0,0 +1,62 @@
+/*
+ * ThreadPool - A fixed set of worker threads that run batches of tasks
+ *
+ *  Created on: Oct 17, 2026
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <pthread.h>
+
+/*
+ * A task of a batch, called once for every index from 0 to the size of the
+ * batch minus one, with the batch's arg.
+ */
+typedef void (*ThreadPoolTask)(void* arg, int index);
+
+/*
+ * A ThreadPool starts its workers once and keeps them asleep between
+ * batches, so a batch costs a wake-up instead of a thread per task. The
+ * thread that runs a batch works on it too, handing out task indexes in
+ * order to whichever thread is free, and returns once every task is done.
+ * Only one thread may run a batch on a pool at a time.
+ * Link with -pthread.
+ */
+typedef struct
+{
+	pthread_t* workers;
+	int threads;			// workers plus the thread running a batch
+	pthread_mutex_t lock;
+	pthread_cond_t wake;	// a batch was started, or the pool is stopping
+	pthread_cond_t done;	// the last task of a batch finished
+	ThreadPoolTask task;
+	void* arg;
+	int count;				// tasks in the batch
+	int next;				// next task index to hand out
+	int finished;			// tasks of the batch that are done
+	unsigned long batch;	// number of batches started
+	int stopping;
+}ThreadPool;
+
+/*
+ * Allocates a ThreadPool that runs batches on threads threads in all, the
+ * calling thread included, so threads - 1 workers are started. If threads
+ * is 0 or less, there's one thread per online processor. Returns NULL on
+ * failure.
+ */
+ThreadPool* ThreadPool_create(int threads);
+/*
+ * Stops the workers and deallocates the pool. No batch may be running.
+ */
+void ThreadPool_free(ThreadPool* pool);
+/*
+ * Runs task(arg, i) for every i from 0 to count - 1 on the threads of the
+ * pool, in no particular order, and waits for all of them to finish.
+ */
+void ThreadPool_run(ThreadPool* pool, ThreadPoolTask task, void* arg, int count);
+/*
+ * Returns the number of threads a batch runs on, the calling one included.
+ */
+int ThreadPool_getThreads(ThreadPool* pool);
+
+#endif
@@ -0,0 +1,249 @@
+/*
+ * TypedDoublyLinkedList - DoublyLinkedLists generated for one element type
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/*
+ * DoublyLinkedList.h has one E per translation unit, which has to be big
+ * enough for anything cast into it, and it compares through a function
+ * pointer. These macros instead generate a separate list type, node type and
+ * set of functions for each element type, named after NAME:
+ *
+ * In a header:
+ * DLL_DECLARE(IntList, int)
+ * In exactly one source file:
+ * DLL_DEFINE(IntList, int, DLL_DEFAULT_COMPARE)
+ *
+ * This gives IntList, IntListNode, IntList_create(), IntList_pushTail(), ...
+ * An IntListNode holds a plain int, and COMPARE is expanded straight into
+ * find and sortedInsert, so it can be inlined. COMPARE(val1, val2) has to
+ * return 0 if val1 == val2, >0 if val1 > val2, and <0 if val1 < val2, just
+ * like DoublyLinkedList.compare; it can be a macro or a (static inline)
+ * function.
+ * Nodes don't point back to their list, so the functions that take a node
+ * take the list too. The nodes have the same head/tail/next/prev fields as
+ * DLLNodes, so DLL_TRAVERSAL and DLL_REVERSE_TRAVERSAL work on them.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#ifndef DLL_TRAVERSAL
+/*
+ * Traverses the list from head to tail, see DoublyLinkedList.h
+ */
+#define DLL_TRAVERSAL(DLL, DLLNODE)										\
+	for(DLLNODE=DLL->head; DLLNODE != NULL; DLLNODE = DLLNODE->next)
+/*
+ * Traverses the list from tail to head, see DoublyLinkedList.h
+ */
+#define DLL_REVERSE_TRAVERSAL(DLL, DLLNODE)								\
+	for(DLLNODE=DLL->tail; DLLNODE != NULL; DLLNODE = DLLNODE->prev)
+#endif
+
+/*
+ * Compares with '<' and '>', for any type that supports them.
+ */
+#define DLL_DEFAULT_COMPARE(VAL1, VAL2)									\
+	(((VAL1) > (VAL2)) - ((VAL1) < (VAL2)))
+
+/*
+ * Declares the NAME and NAME##Node types and the functions of a list of
+ * TYPE. Every function works just like its DoublyLinkedList_ counterpart.
+ */
+#define DLL_DECLARE(NAME, TYPE)											\
+typedef struct NAME##Node												\
+{																		\
+	TYPE data;															\
+	struct NAME##Node* next;											\
+	struct NAME##Node* prev;											\
+}NAME##Node;															\
+typedef struct NAME														\
+{																		\
+	NAME##Node* head;													\
+	NAME##Node* tail;													\
+	size_t size;														\
+	short int sorted;													\
+}NAME;																	\
+NAME* NAME##_create(void);												\
+int NAME##_pushTail(NAME* dll, TYPE data);								\
+int NAME##_pushHead(NAME* dll, TYPE data);								\
+TYPE NAME##_popTail(NAME* dll);											\
+TYPE NAME##_popHead(NAME* dll);											\
+int NAME##_insertAfter(NAME* dll, NAME##Node* handle, TYPE data);		\
+int NAME##_insertBefore(NAME* dll, NAME##Node* handle, TYPE data);		\
+int NAME##_remove(NAME* dll, NAME##Node* element);						\
+NAME##Node* NAME##_find(NAME* dll, TYPE value);							\
+int NAME##_sortedInsert(NAME* dll, TYPE value);							\
+size_t NAME##_getSize(NAME* dll);										\
+void NAME##_free(NAME* dll);
+
+/*
+ * Defines the functions declared by DLL_DECLARE(NAME, TYPE), comparing
+ * values with COMPARE(val1, val2).
+ */
+#define DLL_DEFINE(NAME, TYPE, COMPARE)									\
+/* Allocates a node holding data, or returns NULL. */					\
+static NAME##Node* NAME##_newNode(TYPE data)							\
+{																		\
+	NAME##Node* node = (NAME##Node*)malloc(sizeof(NAME##Node));			\
+	if(node == NULL) return NULL;										\
+	node->data = data;													\
+	node->next = NULL;													\
+	node->prev = NULL;													\
+	return node;														\
+}																		\
+/* Allocates an empty list. */											\
+NAME* NAME##_create(void)												\
+{																		\
+	NAME* dll = (NAME*)malloc(sizeof(NAME));							\
+	if(dll == NULL) return NULL;										\
+	dll->head = NULL;													\
+	dll->tail = NULL;													\
+	dll->size = 0;														\
+	dll->sorted = 0;													\
+	return dll;															\
+}																		\
+/* Creates a node from data and inserts it after handle, or makes it	\
+ * the only node if handle is NULL and the list is empty.				\
+ * Nonzero on failure. */												\
+int NAME##_insertAfter(NAME* dll, NAME##Node* handle, TYPE data)		\
+{																		\
+	if(dll == NULL || (handle == NULL && dll->size > 0)) return 1;		\
+	NAME##Node* newNode = NAME##_newNode(data);							\
+	if(newNode == NULL) return 1;										\
+	newNode->prev = handle;												\
+	if(handle == NULL)													\
+	{																	\
+		dll->head = newNode;											\
+		dll->tail = newNode;											\
+	}																	\
+	else																\
+	{																	\
+		newNode->next = handle->next;									\
+		if(handle->next != NULL) handle->next->prev = newNode;			\
+		else dll->tail = newNode;										\
+		handle->next = newNode;											\
+	}																	\
+	dll->size++;														\
+	return 0;															\
+}																		\
+/* Creates a node from data and inserts it before handle, or makes it	\
+ * the only node if handle is NULL and the list is empty.				\
+ * Nonzero on failure. */												\
+int NAME##_insertBefore(NAME* dll, NAME##Node* handle, TYPE data)		\
+{																		\
+	if(dll == NULL || (handle == NULL && dll->size > 0)) return 1;		\
+	if(handle == NULL || handle->prev != NULL)							\
+		return NAME##_insertAfter(dll, handle ? handle->prev : NULL, data);	\
+	NAME##Node* newNode = NAME##_newNode(data);							\
+	if(newNode == NULL) return 1;										\
+	newNode->next = handle;												\
+	handle->prev = newNode;												\
+	dll->head = newNode;												\
+	dll->size++;														\
+	return 0;															\
+}																		\
+/* Adds an entry to the tail end of the list. Nonzero on error. */		\
+int NAME##_pushTail(NAME* dll, TYPE data)								\
+{																		\
+	if(dll == NULL) return 1;											\
+	if(dll->size == 0) dll->sorted = 0;									\
+	assert(!dll->sorted);												\
+	return NAME##_insertAfter(dll, dll->tail, data);					\
+}																		\
+/* Adds an entry to the head end of the list. Nonzero on error. */		\
+int NAME##_pushHead(NAME* dll, TYPE data)								\
+{																		\
+	if(dll == NULL) return 1;											\
+	if(dll->size == 0) dll->sorted = 0;									\
+	assert(!dll->sorted);												\
+	return NAME##_insertBefore(dll, dll->head, data);					\
+}																		\
+/* Removes an element from the list and deallocates it.				\
+ * Nonzero on failure. */												\
+int NAME##_remove(NAME* dll, NAME##Node* element)						\
+{																		\
+	if(dll == NULL || element == NULL || dll->size == 0) return 1;		\
+	if(element->prev != NULL) element->prev->next = element->next;		\
+	else dll->head = element->next;										\
+	if(element->next != NULL) element->next->prev = element->prev;		\
+	else dll->tail = element->prev;										\
+	dll->size--;														\
+	free(element);														\
+	return 0;															\
+}																		\
+/* Pops and returns the tail off the list. */							\
+TYPE NAME##_popTail(NAME* dll)											\
+{																		\
+	assert(dll != NULL);												\
+	assert(dll->size > 0);												\
+	TYPE returnData = dll->tail->data;									\
+	NAME##_remove(dll, dll->tail);										\
+	return returnData;													\
+}																		\
+/* Pops and returns the head off the list. */							\
+TYPE NAME##_popHead(NAME* dll)											\
+{																		\
+	assert(dll != NULL);												\
+	assert(dll->size > 0);												\
+	TYPE returnData = dll->head->data;									\
+	NAME##_remove(dll, dll->head);										\
+	return returnData;													\
+}																		\
+/* Searches for an element from both ends of the list at once and		\
+ * returns a pointer to its node. Returns NULL if not found. */			\
+NAME##Node* NAME##_find(NAME* dll, TYPE value)							\
+{																		\
+	if(dll == NULL) return NULL;										\
+	NAME##Node* frontPtr = dll->head, *rearPtr = dll->tail;				\
+	size_t i;															\
+	for(i = 0; i < (dll->size+1)/2; i++,								\
+		frontPtr = frontPtr->next, rearPtr = rearPtr->prev)				\
+	{																	\
+		if(!(COMPARE(frontPtr->data, value))) return frontPtr;			\
+		if(!(COMPARE(rearPtr->data, value))) return rearPtr;			\
+	}																	\
+	return NULL;														\
+}																		\
+/* Inserts an element such that the list remains in ascending order.	\
+ * Calling it on an empty list turns automatic sorting on. */			\
+int NAME##_sortedInsert(NAME* dll, TYPE value)							\
+{																		\
+	if(dll == NULL) return 1;											\
+	if(dll->size == 0) dll->sorted = 1;									\
+	assert(dll->sorted);												\
+	NAME##Node* frontPtr = dll->head, *rearPtr = dll->tail;				\
+	size_t i;															\
+	for(i = 0; i < (dll->size+1)/2; i++,								\
+		frontPtr = frontPtr->next, rearPtr = rearPtr->prev)				\
+	{																	\
+		if((COMPARE(frontPtr->data, value)) >= 0)						\
+			return NAME##_insertBefore(dll, frontPtr, value);			\
+		if((COMPARE(rearPtr->data, value)) < 0)							\
+			return NAME##_insertAfter(dll, rearPtr, value);				\
+	}																	\
+	/* on an even size, value goes between the two halves */			\
+	if(frontPtr != NULL) return NAME##_insertBefore(dll, frontPtr, value);	\
+	return NAME##_insertAfter(dll, NULL, value);						\
+}																		\
+/* Returns the number of elements currently in the list. */				\
+size_t NAME##_getSize(NAME* dll)										\
+{																		\
+	if(dll == NULL) return 0;											\
+	return dll->size;													\
+}																		\
+/* Empties and deallocates a list. */									\
+void NAME##_free(NAME* dll)												\
+{																		\
+	if(dll == NULL) return;												\
+	NAME##Node* node = dll->head;										\
+	while(node != NULL)													\
+	{																	\
+		NAME##Node* next = node->next;									\
+		free(node);														\
+		node = next;													\
+	}																	\
+	free(dll);															\
+}
@@ -0,0 +1,269 @@
+/*
+ * UnrolledLinkedList - A doubly linked list whose nodes each hold an array
+ * of up to ULL_NODE_CAPACITY values of type E, so that walking the list
+ * touches one node per ULL_NODE_CAPACITY elements instead of one per element.
+ * E's are generic and can be specified explicitly by calling
+ * #define GENERICS [type]
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "UnrolledLinkedList.h"
+#include "SimdFind.h"
+
+/*
+ * Allocates an empty node and links it into ull after prev (or as the new
+ * head if prev is NULL). Returns NULL on failure.
+ */
+static ULLNode* UnrolledLinkedList_newNode(UnrolledLinkedList* ull, ULLNode* prev)
+{
+	ULLNode* node = (ULLNode*)malloc(sizeof(ULLNode));
+	if(node == NULL) return NULL;
+	node->count = 0;
+	node->list = ull;
+	node->prev = prev;
+	node->next = prev != NULL ? prev->next : ull->head;
+	if(node->next != NULL) node->next->prev = node;
+	else ull->tail = node;
+	if(prev != NULL) prev->next = node;
+	else ull->head = node;
+	return node;
+}
+/*
+ * Unlinks a node from ull and deallocates it.
+ */
+static void UnrolledLinkedList_freeNode(UnrolledLinkedList* ull, ULLNode* node)
+{
+	if(node->prev != NULL) node->prev->next = node->next;
+	else ull->head = node->next;
+	if(node->next != NULL) node->next->prev = node->prev;
+	else ull->tail = node->prev;
+	free(node);
+}
+/*
+ * Inserts data so that it ends up as element index of node, splitting the
+ * node in half first if it's full. Nonzero on failure.
+ */
+static int UnrolledLinkedList_insertAt(ULLNode* node, int index, E data)
+{
+	UnrolledLinkedList* ull = node->list;
+	if(node->count == ULL_NODE_CAPACITY)
+	{
+		ULLNode* newNode = UnrolledLinkedList_newNode(ull, node);
+		if(newNode == NULL) return 1;
+		int half = ULL_NODE_CAPACITY / 2;
+		newNode->count = ULL_NODE_CAPACITY - half;
+		memcpy(newNode->data, node->data + half, newNode->count * sizeof(E));
+		node->count = half;
+		if(index > half)
+		{
+			node = newNode;
+			index -= half;
+		}
+	}
+	memmove(node->data + index + 1, node->data + index,
+			(node->count - index) * sizeof(E));
+	node->data[index] = data;
+	node->count++;
+	ull->size++;
+	return 0;
+}
+/*
+ * Allocates an empty UnrolledLinkedList
+ */
+UnrolledLinkedList* UnrolledLinkedList_create()
+{
+	UnrolledLinkedList* ull = (UnrolledLinkedList*)malloc(sizeof(UnrolledLinkedList));
+	if(ull == NULL) return NULL;
+	ull->head = NULL;
+	ull->tail = NULL;
+	ull->size = 0;
+	ull->compare = NULL;
+	return ull;
+}
+/*
+ * Adds an entry to the tail end of the List. A full tail gets a fresh node
+ * after it rather than being split, so lists built this way stay packed.
+ * Nonzero on failure.
+ */
+int UnrolledLinkedList_pushTail(UnrolledLinkedList* ull, E data)
+{
+	assert(ull != NULL);
+	ULLNode* node = ull->tail;
+	if(node == NULL || node->count == ULL_NODE_CAPACITY)
+	{
+		node = UnrolledLinkedList_newNode(ull, ull->tail);
+		if(node == NULL) return 1;
+	}
+	node->data[node->count++] = data;
+	ull->size++;
+	return 0;
+}
+/*
+ * Adds an entry to the head end of the List. A full head gets a fresh node
+ * before it rather than being split. Nonzero on failure.
+ */
+int UnrolledLinkedList_pushHead(UnrolledLinkedList* ull, E data)
+{
+	assert(ull != NULL);
+	ULLNode* node = ull->head;
+	if(node == NULL || node->count == ULL_NODE_CAPACITY)
+	{
+		node = UnrolledLinkedList_newNode(ull, NULL);
+		if(node == NULL) return 1;
+	}
+	return UnrolledLinkedList_insertAt(node, 0, data);
+}
+/*
+ * Pops and returns the tail off the list
+ */
+E UnrolledLinkedList_popTail(UnrolledLinkedList* ull)
+{
+	assert(ull != NULL);
+	assert(ull->size > 0);
+	E returnData = ull->tail->data[ull->tail->count-1];
+	UnrolledLinkedList_remove(ull->tail, ull->tail->count-1);
+	return returnData;
+}
+/*
+ * Pops and returns the head off the list
+ */
+E UnrolledLinkedList_popHead(UnrolledLinkedList* ull)
+{
+	assert(ull != NULL);
+	assert(ull->size > 0);
+	E returnData = ull->head->data[0];
+	UnrolledLinkedList_remove(ull->head, 0);
+	return returnData;
+}
+/*
+ * Inserts data right after element index of node. Nonzero on failure.
+ */
+int UnrolledLinkedList_insertAfter(ULLNode* node, int index, E data)
+{
+	if(node == NULL || index < 0 || index >= node->count) return 1;
+	return UnrolledLinkedList_insertAt(node, index+1, data);
+}
+/*
+ * Inserts data right before element index of node. Nonzero on failure.
+ */
+int UnrolledLinkedList_insertBefore(ULLNode* node, int index, E data)
+{
+	if(node == NULL || index < 0 || index >= node->count) return 1;
+	return UnrolledLinkedList_insertAt(node, index, data);
+}
+/*
+ * Removes element index of node from the list. A node that drops below a
+ * quarter full is merged with a neighbour if they fit in one node, and an
+ * empty node is deallocated. Nonzero on failure.
+ */
+int UnrolledLinkedList_remove(ULLNode* node, int index)
+{
+	if(node == NULL || index < 0 || index >= node->count) return 1;
+	UnrolledLinkedList* ull = node->list;
+	node->count--;
+	memmove(node->data + index, node->data + index + 1,
+			(node->count - index) * sizeof(E));
+	ull->size--;
+	if(node->count == 0)
+	{
+		UnrolledLinkedList_freeNode(ull, node);
+		return 0;
+	}
+	if(node->count < ULL_NODE_CAPACITY / 4)
+	{
+		if(node->prev != NULL && node->prev->count + node->count <= ULL_NODE_CAPACITY)
+		{
+			ULLNode* prev = node->prev;
+			memcpy(prev->data + prev->count, node->data, node->count * sizeof(E));
+			prev->count += node->count;
+			UnrolledLinkedList_freeNode(ull, node);
+		}
+		else if(node->next != NULL && node->next->count + node->count <= ULL_NODE_CAPACITY)
+		{
+			ULLNode* next = node->next;
+			memcpy(node->data + node->count, next->data, next->count * sizeof(E));
+			node->count += next->count;
+			UnrolledLinkedList_freeNode(ull, next);
+		}
+	}
+	return 0;
+}
+/*
+ * Retrieves element index of node.
+ */
+E UnrolledLinkedList_getData(ULLNode* node, int index)
+{
+	assert(node != NULL);
+	assert(index >= 0 && index < node->count);
+	return node->data[index];
+}
+/*
+ * Returns the index of the first of count values equal to value, or count.
+ * What SIMD_FIND falls back to for E's it has no kernel for.
+ */
+static size_t UnrolledLinkedList_scan(const E* data, size_t count, E value)
+{
+	size_t i;
+	for(i = 0; i < count; i++)
+		if(data[i] == value) return i;
+	return count;
+}
+/*
+ * Searches for an element in the list and returns a pointer to the node
+ * holding it, storing its position in that node in index.
+ * Returns NULL if not found.
+ */
+ULLNode* UnrolledLinkedList_find(UnrolledLinkedList* ull, E value, int* index)
+{
+	if(ull == NULL) return NULL;
+	ULLNode* node;
+	int i;
+	if(ull->compare)
+	{
+		ULL_TRAVERSAL(ull, node, i)
+		{
+			if(!ull->compare(node->data[i], value))
+			{
+				if(index != NULL) *index = i;
+				return node;
+			}
+		}
+		return NULL;
+	}
+	// numeric E's get a SIMD scan of each node's array
+	for(node = ull->head; node != NULL; node = node->next)
+	{
+		const E* data = node->data;
+		size_t found = SIMD_FIND(data, (size_t)node->count, value, UnrolledLinkedList_scan);
+		if(found < (size_t)node->count)
+		{
+			if(index != NULL) *index = (int)found;
+			return node;
+		}
+	}
+	return NULL;
+}
+/*
+ * Returns the number of elements currently in the list.
+ */
+size_t UnrolledLinkedList_getSize(UnrolledLinkedList* ull)
+{
+	if(ull == NULL) return 0;
+	return ull->size;
+}
+/*
+ * Empties and deallocates an UnrolledLinkedList
+ */
+void UnrolledLinkedList_free(UnrolledLinkedList* ull)
+{
+	if(ull == NULL) return;
+	ULLNode* node = ull->head;
+	while(node != NULL)
+	{
+		ULLNode* next = node->next;
+		free(node);
+		node = next;
+	}
+	free(ull);
+}
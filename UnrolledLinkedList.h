@@ -0,0 +1,148 @@
+/*
+ * UnrolledLinkedList - A doubly-linked list of small arrays of E's
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/*
+ * Traverses the list from head to tail
+ * Usage:
+ * ULLNode* handle;
+ * int i;
+ * ULL_TRAVERSAL(list, handle, i)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and handle->data[i] is the current element]
+ * }
+ * (note: break only leaves the current node, since this is two loops)
+ */
+#define ULL_TRAVERSAL(ULL, ULLNODE, I)									\
+	for(ULLNODE=ULL->head; ULLNODE != NULL; ULLNODE = ULLNODE->next)	\
+		for(I = 0; I < ULLNODE->count; I++)
+
+/*
+ * Traverses the list from tail to head
+ * Usage:
+ * ULLNode* handle;
+ * int i;
+ * ULL_REVERSE_TRAVERSAL(list, handle, i)
+ * {
+ *      [this code gets executed list->size times]
+ *      [and handle->data[i] is the current element]
+ * }
+ * (note: break only leaves the current node, since this is two loops)
+ */
+#define ULL_REVERSE_TRAVERSAL(ULL, ULLNODE, I)							\
+	for(ULLNODE=ULL->tail; ULLNODE != NULL; ULLNODE = ULLNODE->prev)	\
+		for(I = ULLNODE->count-1; I >= 0; I--)
+
+/*
+ * E's are long doubles by default, see DoublyLinkedList.h.
+ * To redefine the generics, just call #define GENERICS [type] before
+ * importing UnrolledLinkedList.h
+ */
+#ifndef GENERICS
+#define GENERICS long double
+#endif
+#ifndef GENERICS_TYPEDEF
+#define GENERICS_TYPEDEF
+typedef GENERICS E;
+#endif
+
+/*
+ * Number of E's held by each node. Has to be the same everywhere the list is
+ * used, so redefine it for the whole build rather than per file.
+ */
+#ifndef ULL_NODE_CAPACITY
+#define ULL_NODE_CAPACITY 32
+#endif
+
+/*
+ * A ULLNode (UnrolledLinkedListNode) holds up to ULL_NODE_CAPACITY
+ * consecutive elements of the list in data[0..count-1], plus pointers to the
+ * next and previous ULLNodes (NULL if the node is the head or tail node)
+ * and to the list in which this node is contained.
+ * An element is addressed by its node and its index in that node. Inserting
+ * or removing shifts the elements after it, and can split or merge nodes,
+ * so addresses are only good until the list is next modified.
+ */
+struct ULLNode;
+struct UnrolledLinkedList;
+typedef struct ULLNode
+{
+	struct ULLNode* next;
+	struct ULLNode* prev;
+	struct UnrolledLinkedList* list;
+	int count;
+	E data[ULL_NODE_CAPACITY];
+}ULLNode;
+
+/*
+ * An UnrolledLinkedList consists of a pointer to the head node, a pointer to
+ * the tail node, a size_t representing the number of elements currently in
+ * the list, and a custom compare function pointer that works just like the
+ * one of a DoublyLinkedList.
+ * (important note: Use the UnrolledLinkedList_create() function to allocate
+ * an UnrolledLinkedList)
+ */
+typedef struct UnrolledLinkedList
+{
+	ULLNode* head;
+	ULLNode* tail;
+	size_t size;
+	int (*compare)(E val1, E val2);
+}UnrolledLinkedList;
+
+/*
+ * Allocates an empty UnrolledLinkedList
+ */
+UnrolledLinkedList* UnrolledLinkedList_create();
+/*
+ * Adds an entry to the tail end of the List. Nonzero on failure.
+ */
+int UnrolledLinkedList_pushTail(UnrolledLinkedList* ull, E data);
+/*
+ * Adds an entry to the head end of the List. Nonzero on failure.
+ */
+int UnrolledLinkedList_pushHead(UnrolledLinkedList* ull, E data);
+/*
+ * Pops and returns the tail off the list
+ */
+E UnrolledLinkedList_popTail(UnrolledLinkedList* ull);
+/*
+ * Pops and returns the head off the list
+ */
+E UnrolledLinkedList_popHead(UnrolledLinkedList* ull);
+/*
+ * Inserts data right after element index of node. Nonzero on failure.
+ */
+int UnrolledLinkedList_insertAfter(ULLNode* node, int index, E data);
+/*
+ * Inserts data right before element index of node. Nonzero on failure.
+ */
+int UnrolledLinkedList_insertBefore(ULLNode* node, int index, E data);
+/*
+ * Removes element index of node from the list. Nonzero on failure.
+ */
+int UnrolledLinkedList_remove(ULLNode* node, int index);
+/*
+ * Retrieves element index of node.
+ */
+E UnrolledLinkedList_getData(ULLNode* node, int index);
+/*
+ * Searches for an element in the list and returns a pointer to the node
+ * holding it, storing its position in that node in index.
+ * Returns NULL if not found.
+ * note: this function uses UnrolledLinkedList.compare iff it's been implemented
+ * Without compare, E's of double, float, int32_t or int64_t are scanned with
+ * SIMD (see SimdFind.h), so link with SimdFind.c.
+ */
+ULLNode* UnrolledLinkedList_find(UnrolledLinkedList* ull, E value, int* index);
+/*
+ * Returns the number of elements currently in the list.
+ */
+size_t UnrolledLinkedList_getSize(UnrolledLinkedList* ull);
+/*
+ * Empties and deallocates an UnrolledLinkedList
+ */
+void UnrolledLinkedList_free(UnrolledLinkedList* ull);